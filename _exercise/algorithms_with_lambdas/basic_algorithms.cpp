@@ -4,23 +4,130 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstring>
 #include <functional>
 #include <iostream>
 #include <iterator>
+#include <list>
 #include <numeric>
 #include <random>
+#include <string>
+#include <type_traits>
 #include <vector>
 
 using namespace std;
 
 namespace explain
 {
+    namespace detail
+    {
+        template <typename It>
+        using iter_value_t = typename std::iterator_traits<It>::value_type;
+
+        // iterators over elements stored contiguously in memory (std::contiguous_iterator in C++20)
+        template <typename It, typename = void>
+        struct is_contiguous_iterator : std::is_pointer<It>
+        {
+        };
+
+        template <typename It>
+        struct is_contiguous_iterator<It, std::enable_if_t<!std::is_pointer_v<It> && std::is_object_v<iter_value_t<It>>>>
+            : std::bool_constant<
+                  ((std::is_same_v<It, typename std::vector<iter_value_t<It>>::iterator> || std::is_same_v<It, typename std::vector<iter_value_t<It>>::const_iterator>)
+                      && !std::is_same_v<iter_value_t<It>, bool>) // vector<bool> stores bits
+                  || std::is_same_v<It, std::string::iterator> || std::is_same_v<It, std::string::const_iterator>>
+        {
+        };
+
+        template <typename It>
+        constexpr bool is_contiguous_iterator_v = is_contiguous_iterator<It>::value;
+
+        template <typename InputIt, typename OutputIt>
+        constexpr bool is_memmove_copyable_v = std::conjunction_v<is_contiguous_iterator<InputIt>, is_contiguous_iterator<OutputIt>,
+            std::is_same<std::remove_const_t<iter_value_t<InputIt>>, iter_value_t<OutputIt>>,
+            std::is_trivially_copyable<iter_value_t<OutputIt>>>;
+
+        template <typename OutputIt>
+        struct is_back_insert_iterator : std::false_type
+        {
+        };
+
+        template <typename Container>
+        struct is_back_insert_iterator<std::back_insert_iterator<Container>> : std::true_type
+        {
+        };
+
+        template <typename Container, typename = void>
+        struct has_reserve : std::false_type
+        {
+        };
+
+        template <typename Container>
+        struct has_reserve<Container, std::void_t<decltype(std::declval<Container&>().reserve(std::size_t {})),
+                                          decltype(std::declval<const Container&>().capacity())>> : std::true_type
+        {
+        };
+
+        // back_insert_iterator keeps pointer to its container as protected member
+        template <typename Container>
+        Container& container_of(std::back_insert_iterator<Container>& it)
+        {
+            struct Access : std::back_insert_iterator<Container>
+            {
+                static Container& get(std::back_insert_iterator<Container>& it)
+                {
+                    return *(it.*&Access::container);
+                }
+            };
+
+            return Access::get(it);
+        }
+
+        template <typename InputIt, typename OutputIt>
+        OutputIt copy_generic(InputIt first, InputIt last, OutputIt target_first)
+        {
+            for (InputIt it = first; it != last; ++it)
+            {
+                *target_first++ = *it;
+            }
+
+            return target_first;
+        }
+    }
+
     template <typename InputIt, typename OutputIt>
-    void copy(InputIt first, InputIt last, OutputIt target_first)
+    OutputIt copy(InputIt first, InputIt last, OutputIt target_first)
     {
-        for (InputIt it = first; it != last; ++it)
+        using InputCategory = typename std::iterator_traits<InputIt>::iterator_category;
+
+        if constexpr (detail::is_memmove_copyable_v<InputIt, OutputIt>)
+        {
+            auto count = last - first;
+
+            if (count > 0) // end iterators must not be dereferenced
+                std::memmove(&*target_first, &*first, count * sizeof(detail::iter_value_t<OutputIt>));
+
+            return target_first + count;
+        }
+        else if constexpr (detail::is_back_insert_iterator<OutputIt>::value
+            && std::is_base_of_v<std::forward_iterator_tag, InputCategory>)
         {
-            *target_first++ = *it;
+            using Container = typename OutputIt::container_type;
+
+            if constexpr (detail::has_reserve<Container>::value)
+            {
+                Container& container = detail::container_of(target_first);
+                const std::size_t required = container.size() + std::distance(first, last);
+
+                if (required > container.capacity()) // exact reserve would defeat geometric growth in repeated appends
+                    container.reserve(std::max(required, 2 * container.capacity()));
+            }
+
+            return detail::copy_generic(first, last, target_first);
+        }
+        else
+        {
+            return detail::copy_generic(first, last, target_first);
         }
     }
 }
@@ -34,6 +141,102 @@ TEST_CASE("copy & output iterators")
     std::copy(vec.begin(), vec.end(), std::back_inserter(target));
 }
 
+TEST_CASE("explain::copy")
+{
+    using namespace Catch::Matchers;
+
+    static_assert(explain::detail::is_memmove_copyable_v<std::vector<int>::const_iterator, int*>);
+    static_assert(explain::detail::is_memmove_copyable_v<std::string::iterator, std::vector<char>::iterator>);
+    static_assert(!explain::detail::is_memmove_copyable_v<std::vector<bool>::iterator, std::vector<bool>::iterator>);
+    static_assert(!explain::detail::is_memmove_copyable_v<std::vector<std::string>::iterator, std::vector<std::string>::iterator>);
+    static_assert(!explain::detail::is_memmove_copyable_v<std::vector<int>::iterator, std::vector<long>::iterator>);
+
+    const vector<int> data = {1, 2, 3, 4, 5};
+
+    SECTION("contiguous range of trivially copyable items - memmove")
+    {
+        vector<int> target(data.size());
+
+        auto target_last = explain::copy(data.begin(), data.end(), target.begin());
+
+        REQUIRE(target_last == target.end());
+        REQUIRE_THAT(target, Equals(data));
+    }
+
+    SECTION("empty range")
+    {
+        vector<int> empty;
+        vector<int> target;
+
+        REQUIRE(explain::copy(empty.begin(), empty.end(), target.begin()) == target.begin());
+    }
+
+    SECTION("back_inserter reserves space for forward ranges")
+    {
+        vector<int> target = {0};
+
+        explain::copy(data.begin(), data.end(), std::back_inserter(target));
+
+        REQUIRE_THAT(target, Equals(vector<int> {0, 1, 2, 3, 4, 5}));
+    }
+
+    SECTION("repeated appends with back_inserter keep geometric growth")
+    {
+        vector<int> target;
+        int reallocations = 0;
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            auto capacity = target.capacity();
+            explain::copy(data.begin(), data.begin() + 1, std::back_inserter(target));
+
+            if (target.capacity() != capacity)
+                ++reallocations;
+        }
+
+        REQUIRE(target.size() == 1000);
+        REQUIRE(reallocations <= 11);
+    }
+
+    SECTION("generic fallback")
+    {
+        std::list<std::string> words = {"one", "two", "three"};
+        vector<std::string> target(words.size());
+
+        explain::copy(words.begin(), words.end(), target.begin());
+
+        REQUIRE_THAT(target, Equals(vector<std::string> {"one", "two", "three"}));
+
+        vector<bool> flags = {true, false, true};
+        vector<bool> target_flags(flags.size());
+
+        explain::copy(flags.begin(), flags.end(), target_flags.begin());
+
+        REQUIRE(target_flags == flags);
+    }
+}
+
+TEST_CASE("copy of 10^8 ints", "[.][benchmark]")
+{
+    const vector<int> data(100'000'000, 42);
+    vector<int> target(data.size());
+
+    BENCHMARK("std::copy")
+    {
+        return std::copy(data.begin(), data.end(), target.begin());
+    };
+
+    BENCHMARK("explain::copy")
+    {
+        return explain::copy(data.begin(), data.end(), target.begin());
+    };
+
+    BENCHMARK("explain::detail::copy_generic")
+    {
+        return explain::detail::copy_generic(data.begin(), data.end(), target.begin());
+    };
+}
+
 TEST_CASE("lambda exercise")
 {
     using namespace Catch::Matchers;
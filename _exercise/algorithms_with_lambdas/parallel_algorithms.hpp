@@ -0,0 +1,246 @@
+#ifndef PARALLEL_ALGORITHMS_HPP
+#define PARALLEL_ALGORITHMS_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace parallel
+{
+    class ThreadPool
+    {
+        std::mutex mtx_;
+        std::condition_variable task_available_;
+        std::deque<std::function<void()>> tasks_;
+        bool stopped_ = false;
+        std::vector<std::thread> workers_;
+
+    public:
+        // at least one worker is started - algorithms index per-chunk results by pool.size()
+        explicit ThreadPool(std::size_t size = std::thread::hardware_concurrency())
+        {
+            size = std::max<std::size_t>(1, size);
+
+            workers_.reserve(size);
+            for (std::size_t i = 0; i < size; ++i)
+                workers_.emplace_back([this] { run(); });
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard lk {mtx_};
+                stopped_ = true;
+            }
+            task_available_.notify_all();
+
+            for (auto& worker : workers_)
+                worker.join();
+        }
+
+        std::size_t size() const
+        {
+            return workers_.size();
+        }
+
+        template <typename F>
+        std::future<void> submit(F f)
+        {
+            auto task = std::make_shared<std::packaged_task<void()>>(std::move(f)); // std::function requires copyable callable
+            std::future<void> result = task->get_future();
+
+            {
+                std::lock_guard lk {mtx_};
+                tasks_.push_back([task] { (*task)(); });
+            }
+            task_available_.notify_one();
+
+            return result;
+        }
+
+    private:
+        void run()
+        {
+            while (true)
+            {
+                std::function<void()> task;
+                {
+                    std::unique_lock lk {mtx_};
+                    task_available_.wait(lk, [this] { return stopped_ || !tasks_.empty(); });
+
+                    if (tasks_.empty())
+                        return;
+
+                    task = std::move(tasks_.front());
+                    tasks_.pop_front();
+                }
+
+                task();
+            }
+        }
+    };
+
+    // smaller chunks are not worth a task
+    constexpr std::size_t min_chunk_size = 16 * 1024;
+
+    /////////////////////////////////////////////////////////////////
+    // Splits [first, last) into at most pool.size() chunks of equal size
+    // & calls f(chunk_index, chunk_first, chunk_last) for each of them
+    // - the first chunk is processed by the calling thread
+    // - returns number of chunks
+    //
+    template <typename RandomIt, typename F>
+    std::size_t for_each_chunk(ThreadPool& pool, RandomIt first, RandomIt last, F f)
+    {
+        const std::size_t size = last - first;
+        const std::size_t chunks_count = std::max<std::size_t>(1, std::min(pool.size(), size / min_chunk_size));
+        const std::size_t chunk_size = size / chunks_count;
+
+        auto begin_of = [&](std::size_t chunk) { return first + chunk * chunk_size; };
+        auto end_of = [&](std::size_t chunk) { return chunk + 1 == chunks_count ? last : first + (chunk + 1) * chunk_size; };
+
+        std::vector<std::future<void>> results;
+        results.reserve(chunks_count - 1);
+
+        for (std::size_t chunk = 1; chunk < chunks_count; ++chunk)
+            results.push_back(pool.submit([&f, chunk, chunk_first = begin_of(chunk), chunk_last = end_of(chunk)] {
+                f(chunk, chunk_first, chunk_last);
+            }));
+
+        std::exception_ptr error;
+        try
+        {
+            f(0, begin_of(0), end_of(0));
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        for (auto& result : results)
+            result.wait(); // submitted tasks refer to f & locals of the caller - all of them must finish before unwinding
+
+        if (error)
+            std::rethrow_exception(error);
+
+        for (auto& result : results)
+            result.get(); // rethrows exceptions from chunks
+
+        return chunks_count;
+    }
+
+    template <typename RandomIt, typename Predicate>
+    typename std::iterator_traits<RandomIt>::difference_type count_if(ThreadPool& pool, RandomIt first, RandomIt last, Predicate pred)
+    {
+        using Difference = typename std::iterator_traits<RandomIt>::difference_type;
+
+        std::vector<Difference> counts(pool.size());
+
+        std::size_t chunks_count = for_each_chunk(pool, first, last, [&](std::size_t chunk, RandomIt chunk_first, RandomIt chunk_last) {
+            counts[chunk] = std::count_if(chunk_first, chunk_last, pred);
+        });
+
+        return std::accumulate(counts.begin(), counts.begin() + chunks_count, Difference {});
+    }
+
+    template <typename RandomIt, typename RandomOutputIt, typename UnaryOperation>
+    RandomOutputIt transform(ThreadPool& pool, RandomIt first, RandomIt last, RandomOutputIt target_first, UnaryOperation op)
+    {
+        for_each_chunk(pool, first, last, [&](std::size_t, RandomIt chunk_first, RandomIt chunk_last) {
+            std::transform(chunk_first, chunk_last, target_first + (chunk_first - first), op);
+        });
+
+        return target_first + (last - first);
+    }
+
+    /////////////////////////////////////////////////////////////////
+    // copy_if & partition_copy - order of items is stable:
+    // 1st pass counts matching items in every chunk, prefix sums give an output offset for every chunk,
+    // 2nd pass copies items of chunks to their offsets
+    // - pred is called twice for every item - it should be cheap & must not have side effects
+    //
+    template <typename RandomIt, typename RandomOutputIt, typename Predicate>
+    RandomOutputIt copy_if(ThreadPool& pool, RandomIt first, RandomIt last, RandomOutputIt target_first, Predicate pred)
+    {
+        std::vector<std::size_t> offsets(pool.size() + 1);
+
+        std::size_t chunks_count = for_each_chunk(pool, first, last, [&](std::size_t chunk, RandomIt chunk_first, RandomIt chunk_last) {
+            offsets[chunk + 1] = std::count_if(chunk_first, chunk_last, pred);
+        });
+
+        std::partial_sum(offsets.begin(), offsets.begin() + chunks_count + 1, offsets.begin());
+
+        for_each_chunk(pool, first, last, [&](std::size_t chunk, RandomIt chunk_first, RandomIt chunk_last) {
+            std::copy_if(chunk_first, chunk_last, target_first + offsets[chunk], pred);
+        });
+
+        return target_first + offsets[chunks_count];
+    }
+
+    template <typename RandomIt, typename RandomOutputIt1, typename RandomOutputIt2, typename Predicate>
+    std::pair<RandomOutputIt1, RandomOutputIt2> partition_copy(ThreadPool& pool, RandomIt first, RandomIt last,
+        RandomOutputIt1 target_true, RandomOutputIt2 target_false, Predicate pred)
+    {
+        std::vector<std::size_t> true_offsets(pool.size() + 1);
+        std::vector<std::size_t> false_offsets(pool.size() + 1);
+
+        std::size_t chunks_count = for_each_chunk(pool, first, last, [&](std::size_t chunk, RandomIt chunk_first, RandomIt chunk_last) {
+            std::size_t trues = std::count_if(chunk_first, chunk_last, pred);
+            true_offsets[chunk + 1] = trues;
+            false_offsets[chunk + 1] = (chunk_last - chunk_first) - trues;
+        });
+
+        std::partial_sum(true_offsets.begin(), true_offsets.begin() + chunks_count + 1, true_offsets.begin());
+        std::partial_sum(false_offsets.begin(), false_offsets.begin() + chunks_count + 1, false_offsets.begin());
+
+        for_each_chunk(pool, first, last, [&](std::size_t chunk, RandomIt chunk_first, RandomIt chunk_last) {
+            std::partition_copy(chunk_first, chunk_last, target_true + true_offsets[chunk], target_false + false_offsets[chunk], pred);
+        });
+
+        return {target_true + true_offsets[chunks_count], target_false + false_offsets[chunks_count]};
+    }
+
+    /////////////////////////////////////////////////////////////////
+    // remove_if - chunks are compacted in parallel, then moved together by the calling thread
+    //
+    template <typename RandomIt, typename Predicate>
+    RandomIt remove_if(ThreadPool& pool, RandomIt first, RandomIt last, Predicate pred)
+    {
+        std::vector<std::pair<RandomIt, RandomIt>> kept(pool.size()); // [chunk_first, new chunk end)
+
+        std::size_t chunks_count = for_each_chunk(pool, first, last, [&](std::size_t chunk, RandomIt chunk_first, RandomIt chunk_last) {
+            kept[chunk] = {chunk_first, std::remove_if(chunk_first, chunk_last, pred)};
+        });
+
+        RandomIt new_end = kept[0].second;
+        for (std::size_t chunk = 1; chunk < chunks_count; ++chunk)
+        {
+            if (new_end == kept[chunk].first) // nothing removed so far - chunk is already in place
+            {
+                new_end = kept[chunk].second;
+                continue;
+            }
+
+            for (RandomIt it = kept[chunk].first; it != kept[chunk].second; ++it, ++new_end) // target is always before the source
+                *new_end = std::move(*it);
+        }
+
+        return new_end;
+    }
+}
+
+#endif // PARALLEL_ALGORITHMS_HPP
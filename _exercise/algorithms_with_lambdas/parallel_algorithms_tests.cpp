@@ -0,0 +1,277 @@
+#include "catch.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "parallel_algorithms.hpp"
+
+using namespace std;
+using namespace std::chrono_literals;
+
+TEST_CASE("parallel lambda exercise")
+{
+    using namespace Catch::Matchers;
+
+    parallel::ThreadPool pool {4};
+
+    vector<int> data = {1, 6, 3, 5, 8, 9, 13, 12, 10, 45};
+
+    auto is_even = [](int value) { return value % 2 == 0; };
+
+    SECTION("count even numbers")
+    {
+        auto evens_count = parallel::count_if(pool, data.begin(), data.end(), is_even);
+
+        REQUIRE(evens_count == 4);
+    }
+
+    SECTION("copy evens to vector")
+    {
+        vector<int> evens(data.size());
+
+        evens.erase(parallel::copy_if(pool, data.begin(), data.end(), evens.begin(), is_even), evens.end());
+
+        REQUIRE_THAT(evens, Equals(vector<int> {6, 8, 12, 10}));
+    }
+
+    SECTION("create container with squares")
+    {
+        vector<int> squares(data.size());
+
+        parallel::transform(pool, data.begin(), data.end(), squares.begin(), [](int value) { return value * value; });
+
+        REQUIRE_THAT(squares, Equals(vector<int> {1, 36, 9, 25, 64, 81, 169, 144, 100, 2025}));
+    }
+
+    SECTION("remove from container even items")
+    {
+        data.erase(parallel::remove_if(pool, data.begin(), data.end(), is_even), data.end());
+
+        REQUIRE(std::all_of(data.begin(), data.end(), [is_even](int n) { return !is_even(n); }));
+    }
+
+    SECTION("remove from container items divisible by any number from a given array")
+    {
+        const array<int, 3> eliminators = {3, 5, 7};
+
+        auto new_end = parallel::remove_if(pool, data.begin(), data.end(), [&eliminators](int dv) {
+            return std::any_of(eliminators.begin(), eliminators.end(), [dv](int ev) { return dv % ev == 0; });
+        });
+
+        data.erase(new_end, data.end());
+
+        REQUIRE_THAT(data, Equals(vector<int> {1, 8, 13}));
+    }
+
+    SECTION("create two containers - 1st with numbers less or equal to average & 2nd with numbers greater than average")
+    {
+        double avg = std::accumulate(data.begin(), data.end(), 0.0) / data.size();
+
+        vector<int> less_equal_than_avg(data.size());
+        vector<int> greater_than_avg(data.size());
+
+        auto [less_equal_end, greater_end] = parallel::partition_copy(pool, data.begin(), data.end(),
+            less_equal_than_avg.begin(), greater_than_avg.begin(), [avg](int value) { return value <= avg; });
+
+        less_equal_than_avg.erase(less_equal_end, less_equal_than_avg.end());
+        greater_than_avg.erase(greater_end, greater_than_avg.end());
+
+        REQUIRE_THAT(less_equal_than_avg, Equals(vector<int> {1, 6, 3, 5, 8, 9, 10}));
+        REQUIRE_THAT(greater_than_avg, Equals(vector<int> {13, 12, 45}));
+    }
+}
+
+TEST_CASE("parallel algorithms on many chunks match serial ones")
+{
+    using namespace Catch::Matchers;
+
+    parallel::ThreadPool pool {4};
+
+    vector<int> data(10 * parallel::min_chunk_size + 17);
+    std::mt19937 rnd {665};
+    std::uniform_int_distribution<int> distribution {0, 1000};
+    std::generate(data.begin(), data.end(), [&] { return distribution(rnd); });
+
+    auto is_even = [](int value) { return value % 2 == 0; };
+
+    SECTION("count_if")
+    {
+        REQUIRE(parallel::count_if(pool, data.begin(), data.end(), is_even) == std::count_if(data.begin(), data.end(), is_even));
+    }
+
+    SECTION("copy_if keeps order")
+    {
+        vector<int> expected;
+        std::copy_if(data.begin(), data.end(), std::back_inserter(expected), is_even);
+
+        vector<int> evens(data.size());
+        evens.erase(parallel::copy_if(pool, data.begin(), data.end(), evens.begin(), is_even), evens.end());
+
+        REQUIRE_THAT(evens, Equals(expected));
+    }
+
+    SECTION("transform")
+    {
+        vector<int> expected;
+        std::transform(data.begin(), data.end(), std::back_inserter(expected), [](int value) { return value * value; });
+
+        vector<int> squares(data.size());
+        parallel::transform(pool, data.begin(), data.end(), squares.begin(), [](int value) { return value * value; });
+
+        REQUIRE_THAT(squares, Equals(expected));
+    }
+
+    SECTION("remove_if keeps order")
+    {
+        vector<int> expected = data;
+        expected.erase(std::remove_if(expected.begin(), expected.end(), is_even), expected.end());
+
+        data.erase(parallel::remove_if(pool, data.begin(), data.end(), is_even), data.end());
+
+        REQUIRE_THAT(data, Equals(expected));
+    }
+
+    SECTION("partition_copy keeps order")
+    {
+        vector<int> expected_evens, expected_odds;
+        std::partition_copy(data.begin(), data.end(), std::back_inserter(expected_evens), std::back_inserter(expected_odds), is_even);
+
+        vector<int> evens(data.size()), odds(data.size());
+        auto [evens_end, odds_end] = parallel::partition_copy(pool, data.begin(), data.end(), evens.begin(), odds.begin(), is_even);
+        evens.erase(evens_end, evens.end());
+        odds.erase(odds_end, odds.end());
+
+        REQUIRE_THAT(evens, Equals(expected_evens));
+        REQUIRE_THAT(odds, Equals(expected_odds));
+    }
+}
+
+TEST_CASE("parallel remove_if of non-trivial items")
+{
+    parallel::ThreadPool pool {4};
+
+    vector<vector<int>> data(4 * parallel::min_chunk_size);
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = {static_cast<int>(i)};
+
+    SECTION("nothing removed - items are not moved onto themselves")
+    {
+        auto new_end = parallel::remove_if(pool, data.begin(), data.end(), [](const vector<int>&) { return false; });
+
+        REQUIRE(new_end == data.end());
+        for (size_t i = 0; i < data.size(); ++i)
+            REQUIRE(data[i] == vector<int> {static_cast<int>(i)});
+    }
+
+    SECTION("items of later chunks are moved to the front")
+    {
+        auto new_end = parallel::remove_if(pool, data.begin(), data.end(), [](const vector<int>& item) { return item[0] % 3 == 0; });
+        data.erase(new_end, data.end());
+
+        REQUIRE(data.size() == 4 * parallel::min_chunk_size - (4 * parallel::min_chunk_size + 2) / 3);
+        REQUIRE(std::all_of(data.begin(), data.end(), [](const vector<int>& item) { return item.size() == 1 && item[0] % 3 != 0; }));
+        REQUIRE(std::is_sorted(data.begin(), data.end()));
+    }
+}
+
+TEST_CASE("parallel algorithms - edge cases")
+{
+    vector<int> data(4 * parallel::min_chunk_size, 1);
+
+    SECTION("pool of size 0 has one worker")
+    {
+        parallel::ThreadPool pool {0};
+
+        REQUIRE(pool.size() == 1);
+        REQUIRE(parallel::count_if(pool, data.begin(), data.end(), [](int value) { return value == 1; }) == std::count(data.begin(), data.end(), 1));
+    }
+
+    SECTION("exception thrown in the calling thread is propagated after all chunks are done")
+    {
+        parallel::ThreadPool pool {4};
+        data.front() = 0;
+
+        REQUIRE_THROWS_AS(parallel::count_if(pool, data.begin(), data.end(), [](int value) {
+            if (value == 0)
+                throw std::invalid_argument("0");
+            return true;
+        }),
+            std::invalid_argument);
+    }
+
+    SECTION("exception thrown in a chunk is propagated after the remaining chunks are done")
+    {
+        parallel::ThreadPool pool {4};
+        for (size_t i = 0; i < data.size(); ++i)
+            data[i] = static_cast<int>(i / parallel::min_chunk_size); // value == index of chunk
+
+        std::atomic<bool> slowed_down {false};
+        std::atomic<size_t> last_chunk_calls {0};
+
+        REQUIRE_THROWS_AS(parallel::count_if(pool, data.begin(), data.end(), [&](int chunk) {
+            if (chunk == 1)
+                throw std::invalid_argument("1");
+
+            if (chunk == 3)
+            {
+                if (!slowed_down.exchange(true))
+                    std::this_thread::sleep_for(50ms);
+                ++last_chunk_calls;
+            }
+
+            return true;
+        }),
+            std::invalid_argument);
+
+        REQUIRE(last_chunk_calls == parallel::min_chunk_size);
+    }
+}
+
+TEST_CASE("parallel algorithms - 1..N threads", "[.][benchmark]")
+{
+    vector<int> data(50'000'000);
+    std::iota(data.begin(), data.end(), 0);
+    vector<int> target(data.size());
+
+    auto is_even = [](int value) { return value % 2 == 0; };
+
+    for (std::size_t threads = 1; threads <= std::max(1u, std::thread::hardware_concurrency()); threads *= 2)
+    {
+        parallel::ThreadPool pool {threads};
+        const std::string suffix = " - " + std::to_string(threads) + " threads";
+
+        BENCHMARK("count_if" + suffix)
+        {
+            return parallel::count_if(pool, data.begin(), data.end(), is_even);
+        };
+
+        BENCHMARK("copy_if" + suffix)
+        {
+            return parallel::copy_if(pool, data.begin(), data.end(), target.begin(), is_even);
+        };
+
+        BENCHMARK("transform" + suffix)
+        {
+            return parallel::transform(pool, data.begin(), data.end(), target.begin(), [](int value) { return value * value; });
+        };
+
+        BENCHMARK("partition_copy" + suffix)
+        {
+            return parallel::partition_copy(pool, data.begin(), data.end(), target.begin(), target.rbegin(), is_even);
+        };
+
+        BENCHMARK("remove_if" + suffix)
+        {
+            target = data;
+            return parallel::remove_if(pool, target.begin(), target.end(), is_even);
+        };
+    }
+}
@@ -0,0 +1,220 @@
+#ifndef PIPELINE_HPP
+#define PIPELINE_HPP
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/////////////////////////////////////////////////////////////////
+// Lazy, push-based pipelines: from(data) | filter(is_even) | map(square) | sum()
+// - stages are fused into one loop over the source - no intermediate containers
+// - the pipeline is executed when a terminal (sum, count, to_vector, reduce, for_each) is applied
+// - type of items is tracked through the stages (map changes it to the result of the function)
+// - an lvalue source is held by reference - it must outlive the pipeline
+//
+namespace pipeline
+{
+    template <typename Predicate>
+    struct Filter
+    {
+        Predicate pred;
+
+        template <typename T>
+        using output_t = T;
+
+        template <typename Sink>
+        auto wrap(Sink sink) const
+        {
+            return [pred = pred, sink](auto&& item) mutable {
+                if (std::invoke(pred, item))
+                    sink(std::forward<decltype(item)>(item));
+            };
+        }
+    };
+
+    template <typename Function>
+    struct Map
+    {
+        Function f;
+
+        template <typename T>
+        using output_t = std::decay_t<std::invoke_result_t<const Function&, const T&>>;
+
+        template <typename Sink>
+        auto wrap(Sink sink) const
+        {
+            return [f = f, sink](auto&& item) mutable {
+                sink(std::invoke(f, std::forward<decltype(item)>(item)));
+            };
+        }
+    };
+
+    template <typename Predicate>
+    Filter<Predicate> filter(Predicate pred)
+    {
+        return {std::move(pred)};
+    }
+
+    template <typename Function>
+    Map<Function> map(Function f)
+    {
+        return {std::move(f)};
+    }
+
+    namespace detail
+    {
+        template <typename T, typename... Stages>
+        struct output_of;
+
+        template <typename T>
+        struct output_of<T>
+        {
+            using type = T;
+        };
+
+        template <typename T, typename Stage, typename... Stages>
+        struct output_of<T, Stage, Stages...> : output_of<typename Stage::template output_t<T>, Stages...>
+        {
+        };
+
+        struct TerminalTag
+        {
+        };
+    }
+
+    template <typename Range, typename... Stages>
+    class Pipeline
+    {
+        Range source_; // reference for lvalue sources
+        std::tuple<Stages...> stages_;
+
+    public:
+        using source_value_type = std::decay_t<decltype(*std::begin(std::declval<Range&>()))>;
+        using value_type = typename detail::output_of<source_value_type, Stages...>::type;
+
+        Pipeline(Range&& source, std::tuple<Stages...> stages)
+            : source_ {std::forward<Range>(source)}
+            , stages_ {std::move(stages)}
+        {
+        }
+
+        // pushes every item of the source through the stages to the sink
+        template <typename Sink>
+        void run(Sink sink)
+        {
+            auto fused = compose<0>(std::move(sink));
+
+            for (auto&& item : source_)
+                fused(item);
+        }
+
+        template <typename Stage, std::enable_if_t<!std::is_base_of_v<detail::TerminalTag, Stage>, int> = 0>
+        friend Pipeline<Range, Stages..., Stage> operator|(Pipeline pipeline, Stage stage)
+        {
+            return {std::forward<Range>(pipeline.source_), std::tuple_cat(std::move(pipeline.stages_), std::make_tuple(std::move(stage)))};
+        }
+
+        template <typename Terminal, std::enable_if_t<std::is_base_of_v<detail::TerminalTag, Terminal>, int> = 0>
+        friend auto operator|(Pipeline pipeline, Terminal terminal)
+        {
+            return terminal.apply(pipeline);
+        }
+
+    private:
+        template <std::size_t Index, typename Sink>
+        auto compose(Sink sink) const
+        {
+            if constexpr (Index == sizeof...(Stages))
+                return sink;
+            else
+                return std::get<Index>(stages_).wrap(compose<Index + 1>(std::move(sink)));
+        }
+    };
+
+    template <typename Range>
+    Pipeline<Range> from(Range&& source)
+    {
+        return {std::forward<Range>(source), std::tuple<> {}};
+    }
+
+    /////////////////////////////////////////////////////////////////
+    // Terminals
+    //
+    struct sum : detail::TerminalTag
+    {
+        template <typename Pipeline>
+        auto apply(Pipeline& pipeline) const
+        {
+            typename Pipeline::value_type total {};
+            pipeline.run([&total](const auto& item) { total += item; });
+            return total;
+        }
+    };
+
+    struct count : detail::TerminalTag
+    {
+        template <typename Pipeline>
+        std::size_t apply(Pipeline& pipeline) const
+        {
+            std::size_t counter = 0;
+            pipeline.run([&counter](const auto&) { ++counter; });
+            return counter;
+        }
+    };
+
+    struct to_vector : detail::TerminalTag
+    {
+        template <typename Pipeline>
+        auto apply(Pipeline& pipeline) const
+        {
+            std::vector<typename Pipeline::value_type> result;
+            pipeline.run([&result](auto&& item) { result.push_back(std::forward<decltype(item)>(item)); });
+            return result;
+        }
+    };
+
+    template <typename T, typename BinaryOperation>
+    struct Reduce : detail::TerminalTag
+    {
+        T init;
+        BinaryOperation op;
+
+        template <typename Pipeline>
+        T apply(Pipeline& pipeline) const
+        {
+            T accumulator = init;
+            pipeline.run([this, &accumulator](auto&& item) { accumulator = std::invoke(op, std::move(accumulator), std::forward<decltype(item)>(item)); });
+            return accumulator;
+        }
+    };
+
+    template <typename T, typename BinaryOperation = std::plus<>>
+    Reduce<T, BinaryOperation> reduce(T init, BinaryOperation op = {})
+    {
+        return {{}, std::move(init), std::move(op)};
+    }
+
+    template <typename Function>
+    struct ForEach : detail::TerminalTag
+    {
+        Function f;
+
+        template <typename Pipeline>
+        void apply(Pipeline& pipeline) const
+        {
+            pipeline.run([this](auto&& item) { std::invoke(f, std::forward<decltype(item)>(item)); });
+        }
+    };
+
+    template <typename Function>
+    ForEach<Function> for_each(Function f)
+    {
+        return {{}, std::move(f)};
+    }
+}
+
+#endif // PIPELINE_HPP
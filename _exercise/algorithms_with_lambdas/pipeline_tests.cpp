@@ -0,0 +1,107 @@
+#include "catch.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "pipeline.hpp"
+
+using namespace std;
+
+TEST_CASE("lazy pipelines")
+{
+    using namespace Catch::Matchers;
+
+    vector<int> data = {1, 6, 3, 5, 8, 9, 13, 12, 10, 45};
+
+    auto is_even = [](int value) { return value % 2 == 0; };
+    auto square = [](int value) { return value * value; };
+
+    SECTION("count even numbers")
+    {
+        REQUIRE((pipeline::from(data) | pipeline::filter(is_even) | pipeline::count()) == 4);
+    }
+
+    SECTION("copy evens to vector")
+    {
+        auto evens = pipeline::from(data) | pipeline::filter(is_even) | pipeline::to_vector();
+
+        REQUIRE_THAT(evens, Equals(vector<int> {6, 8, 12, 10}));
+    }
+
+    SECTION("create container with squares")
+    {
+        auto squares = pipeline::from(data) | pipeline::map(square) | pipeline::to_vector();
+
+        REQUIRE_THAT(squares, Equals(vector<int> {1, 36, 9, 25, 64, 81, 169, 144, 100, 2025}));
+    }
+
+    SECTION("sum of squares of evens")
+    {
+        auto sum = pipeline::from(data) | pipeline::filter(is_even) | pipeline::map(square) | pipeline::sum();
+
+        REQUIRE(sum == 36 + 64 + 144 + 100);
+    }
+
+    SECTION("type of items is tracked through stages")
+    {
+        auto texts = pipeline::from(data) | pipeline::filter(is_even) | pipeline::map([](int value) { return std::to_string(value); })
+            | pipeline::map([](const std::string& text) { return text + "!"; }) | pipeline::to_vector();
+
+        static_assert(std::is_same_v<decltype(texts), vector<std::string>>);
+        REQUIRE_THAT(texts, Equals(vector<std::string> {"6!", "8!", "12!", "10!"}));
+    }
+
+    SECTION("reduce")
+    {
+        auto max = pipeline::from(data) | pipeline::map(square)
+            | pipeline::reduce(0, [](int a, int b) { return std::max(a, b); });
+
+        REQUIRE(max == 2025);
+    }
+
+    SECTION("for_each")
+    {
+        vector<int> odds;
+
+        pipeline::from(data) | pipeline::filter([is_even](int value) { return !is_even(value); })
+            | pipeline::for_each([&odds](int value) { odds.push_back(value); });
+
+        REQUIRE_THAT(odds, Equals(vector<int> {1, 3, 5, 9, 13, 45}));
+    }
+
+    SECTION("temporary source is moved into pipeline")
+    {
+        auto sum = pipeline::from(vector<int> {1, 2, 3, 4}) | pipeline::map(square) | pipeline::sum();
+
+        REQUIRE(sum == 30);
+    }
+}
+
+TEST_CASE("fused pipeline vs. multi-pass algorithms", "[.][benchmark]")
+{
+    vector<int> data(10'000'000);
+    std::iota(data.begin(), data.end(), 0);
+    std::transform(data.begin(), data.end(), data.begin(), [](int value) { return value % 1000; });
+
+    auto is_even = [](int value) { return value % 2 == 0; };
+    auto square = [](int value) { return value * value; };
+
+    BENCHMARK("copy_if + transform + accumulate")
+    {
+        vector<int> evens;
+        std::copy_if(data.begin(), data.end(), std::back_inserter(evens), is_even);
+
+        vector<int> squares;
+        std::transform(evens.begin(), evens.end(), std::back_inserter(squares), square);
+
+        return std::accumulate(squares.begin(), squares.end(), 0LL);
+    };
+
+    BENCHMARK("from | filter | map | reduce")
+    {
+        return pipeline::from(data) | pipeline::filter(is_even) | pipeline::map(square) | pipeline::reduce(0LL);
+    };
+}
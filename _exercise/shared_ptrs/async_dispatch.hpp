@@ -0,0 +1,232 @@
+#ifndef ASYNC_DISPATCH_HPP
+#define ASYNC_DISPATCH_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "temp_monitor.hpp"
+
+enum class OverflowPolicy
+{
+    drop_oldest,
+    drop_newest,
+    block // set_temp() waits until observer catches up - observer must not call set_temp() itself
+};
+
+struct DispatchOptions
+{
+    std::size_t capacity = 64;
+    OverflowPolicy overflow = OverflowPolicy::drop_oldest;
+};
+
+struct LagMetrics
+{
+    std::uint64_t enqueued = 0;
+    std::uint64_t delivered = 0;
+    std::uint64_t dropped = 0;
+    std::size_t depth = 0;
+    std::size_t max_depth = 0;
+    std::chrono::nanoseconds last_latency {0}; // time from event timestamp to delivery
+    std::chrono::nanoseconds max_latency {0};
+};
+
+class AsyncChannel;
+
+/////////////////////////////////////////////////////////////////
+// Pool of worker threads draining scheduled channels
+// - must outlive all monitors that use it
+// - pending channels are drained before the workers are stopped
+//
+class AsyncDispatcher
+{
+    std::mutex mtx_;
+    std::condition_variable work_available_;
+    std::deque<std::shared_ptr<AsyncChannel>> ready_;
+    bool stopped_ = false;
+    std::vector<std::thread> workers_;
+
+public:
+    explicit AsyncDispatcher(std::size_t workers_count = std::max(1u, std::thread::hardware_concurrency()))
+    {
+        workers_.reserve(workers_count);
+        for (std::size_t i = 0; i < workers_count; ++i)
+            workers_.emplace_back([this] { run(); });
+    }
+
+    AsyncDispatcher(const AsyncDispatcher&) = delete;
+    AsyncDispatcher& operator=(const AsyncDispatcher&) = delete;
+
+    ~AsyncDispatcher()
+    {
+        {
+            std::lock_guard lk {mtx_};
+            stopped_ = true;
+        }
+        work_available_.notify_all();
+
+        for (auto& worker : workers_)
+            worker.join();
+    }
+
+    void schedule(std::shared_ptr<AsyncChannel> channel)
+    {
+        {
+            std::lock_guard lk {mtx_};
+            ready_.push_back(std::move(channel));
+        }
+        work_available_.notify_one();
+    }
+
+private:
+    void run();
+};
+
+/////////////////////////////////////////////////////////////////
+// Bounded queue of events for one observer
+// - channel is scheduled on the dispatcher at most once at a time,
+//   so events are delivered to the observer in order of enqueuing
+// - events are delivered without holding the lock
+// - at most capacity events wait in the queue (depth) + one event is being delivered
+//
+class AsyncChannel : public NotificationForwarder, public std::enable_shared_from_this<AsyncChannel>
+{
+    std::weak_ptr<Observer> target_;
+    AsyncDispatcher& dispatcher_;
+    DispatchOptions options_;
+
+    mutable std::mutex mtx_;
+    std::condition_variable not_full_;
+    std::deque<TempChanged> events_;
+    bool scheduled_ = false;
+    LagMetrics metrics_;
+
+public:
+    AsyncChannel(std::weak_ptr<Observer> target, AsyncDispatcher& dispatcher, DispatchOptions options)
+        : target_ {std::move(target)}
+        , dispatcher_ {dispatcher}
+        , options_ {options}
+    {
+        options_.capacity = std::max<std::size_t>(options_.capacity, 1);
+    }
+
+    void update(TempChanged event) override
+    {
+        std::unique_lock lk {mtx_};
+
+        if (events_.size() == options_.capacity)
+        {
+            switch (options_.overflow)
+            {
+            case OverflowPolicy::drop_oldest:
+                events_.pop_front();
+                ++metrics_.dropped;
+                break;
+            case OverflowPolicy::drop_newest:
+                ++metrics_.dropped;
+                return;
+            case OverflowPolicy::block:
+                not_full_.wait(lk, [this] { return events_.size() < options_.capacity; });
+                break;
+            }
+        }
+
+        events_.push_back(event);
+        ++metrics_.enqueued;
+        metrics_.depth = events_.size();
+        metrics_.max_depth = std::max(metrics_.max_depth, metrics_.depth);
+
+        if (!std::exchange(scheduled_, true))
+        {
+            lk.unlock();
+            dispatcher_.schedule(shared_from_this());
+        }
+    }
+
+    LagMetrics metrics() const
+    {
+        std::lock_guard lk {mtx_};
+        return metrics_;
+    }
+
+    // called by a worker of the dispatcher
+    void drain()
+    {
+        std::shared_ptr<Observer> target = target_.lock();
+
+        std::unique_lock lk {mtx_};
+
+        // events are popped one at a time - a slot in the queue is released only when its event is taken for delivery;
+        // at most the events queued at the start are delivered, so other channels are not starved
+        for (std::size_t budget = events_.size(); budget > 0 && !events_.empty(); --budget)
+        {
+            TempChanged event = events_.front();
+            events_.pop_front();
+            metrics_.depth = events_.size();
+
+            if (!target)
+            {
+                ++metrics_.dropped;
+                continue;
+            }
+
+            lk.unlock();
+            not_full_.notify_all();
+
+            target->update(event);
+            auto latency = std::chrono::steady_clock::now() - event.timestamp;
+
+            lk.lock();
+            ++metrics_.delivered;
+            metrics_.last_latency = latency;
+            metrics_.max_latency = std::max(metrics_.max_latency, metrics_.last_latency);
+        }
+
+        bool reschedule = !events_.empty();
+        scheduled_ = reschedule;
+        lk.unlock();
+        not_full_.notify_all();
+
+        if (reschedule)
+            dispatcher_.schedule(shared_from_this()); // back to the end of the queue - other channels are not starved
+    }
+};
+
+inline void AsyncDispatcher::run()
+{
+    while (true)
+    {
+        std::shared_ptr<AsyncChannel> channel;
+        {
+            std::unique_lock lk {mtx_};
+            work_available_.wait(lk, [this] { return stopped_ || !ready_.empty(); });
+
+            if (ready_.empty())
+                return;
+
+            channel = std::move(ready_.front());
+            ready_.pop_front();
+        }
+
+        channel->drain();
+    }
+}
+
+// notifications for observer are queued & delivered by workers of dispatcher
+inline std::shared_ptr<const AsyncChannel> register_async_observer(TempMonitor& monitor, std::weak_ptr<Observer> observer,
+    AsyncDispatcher& dispatcher, DispatchOptions options = {})
+{
+    auto channel = std::make_shared<AsyncChannel>(observer, dispatcher, options);
+    monitor.register_observer(std::move(observer), channel);
+    return channel;
+}
+
+#endif // ASYNC_DISPATCH_HPP
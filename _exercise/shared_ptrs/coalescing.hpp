@@ -0,0 +1,131 @@
+#ifndef COALESCING_HPP
+#define COALESCING_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+#include "temp_monitor.hpp"
+
+struct CoalescingOptions
+{
+    std::chrono::steady_clock::duration min_interval = std::chrono::milliseconds(100); // max rate of notifications
+    int hysteresis = 0; // changes not greater than hysteresis (relative to the last delivered value) are ignored
+};
+
+struct CoalescingStats
+{
+    std::uint64_t received = 0;
+    std::uint64_t delivered = 0;
+};
+
+/////////////////////////////////////////////////////////////////
+// Delivers only the most recent temperature to an observer
+// - at most one notification per min_interval
+// - a value held back by the rate limit is pending (dirty) until it is replaced by a newer one
+//   or delivered by flush_pending()
+// - old_temp of the delivered event is the last value delivered to the observer
+// - deliveries from update() & flush_pending() are serialized: a value is passed to the observer
+//   only if no newer value has been chosen for delivery in the meantime
+//   (observer must not call set_temp() of the monitor inside update())
+//
+class CoalescingFilter : public NotificationForwarder
+{
+    std::weak_ptr<Observer> target_;
+    const CoalescingOptions options_;
+
+    mutable std::mutex mtx_;
+    std::optional<int> delivered_temp_;
+    std::chrono::steady_clock::time_point last_delivery_;
+    std::optional<TempChanged> pending_;
+    std::uint64_t deliveries_ = 0; // number of values chosen for delivery
+    CoalescingStats stats_;
+
+    std::mutex delivery_mtx_; // serializes calls of the observer
+    std::optional<int> observed_temp_; // last value passed to the observer - guarded by delivery_mtx_
+
+public:
+    CoalescingFilter(std::weak_ptr<Observer> target, CoalescingOptions options)
+        : target_ {std::move(target)}
+        , options_ {options}
+    {
+    }
+
+    void update(TempChanged event) override
+    {
+        std::unique_lock lk {mtx_};
+
+        ++stats_.received;
+
+        if (delivered_temp_ && std::abs(event.new_temp - *delivered_temp_) <= options_.hysteresis)
+        {
+            pending_.reset(); // latest value is within hysteresis of the delivered one
+            return;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (delivered_temp_ && now - last_delivery_ < options_.min_interval)
+        {
+            pending_ = event;
+            return;
+        }
+
+        deliver(lk, event, now);
+    }
+
+    void flush_pending(std::chrono::steady_clock::time_point now) override
+    {
+        std::unique_lock lk {mtx_};
+
+        if (pending_ && now - last_delivery_ >= options_.min_interval)
+            deliver(lk, *pending_, now);
+    }
+
+    CoalescingStats stats() const
+    {
+        std::lock_guard lk {mtx_};
+        return stats_;
+    }
+
+private:
+    void deliver(std::unique_lock<std::mutex>& lk, TempChanged event, std::chrono::steady_clock::time_point now)
+    {
+        delivered_temp_ = event.new_temp;
+        last_delivery_ = now;
+        pending_.reset();
+        const std::uint64_t delivery = ++deliveries_;
+
+        lk.unlock(); // observer is called without holding the lock
+
+        std::lock_guard delivery_lk {delivery_mtx_};
+
+        lk.lock();
+        if (delivery != deliveries_)
+            return; // newer value has been chosen meanwhile - it is delivered instead of this one
+        ++stats_.delivered;
+        lk.unlock();
+
+        if (observed_temp_)
+            event.old_temp = *observed_temp_;
+        observed_temp_ = event.new_temp;
+
+        if (std::shared_ptr<Observer> target = target_.lock(); target)
+            target->update(event);
+    }
+};
+
+// notifications for observer are rate limited & coalesced - TempMonitor::flush_pending() should be called
+// periodically (e.g. every min_interval) to deliver trailing values
+inline std::shared_ptr<const CoalescingFilter> register_coalescing_observer(TempMonitor& monitor, std::weak_ptr<Observer> observer,
+    CoalescingOptions options = {})
+{
+    auto filter = std::make_shared<CoalescingFilter>(observer, options);
+    monitor.register_observer(std::move(observer), filter);
+    return filter;
+}
+
+#endif // COALESCING_HPP
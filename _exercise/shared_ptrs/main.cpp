@@ -2,81 +2,12 @@
 #include <cstdlib>
 #include <iostream>
 #include <memory>
-#include <set>
 #include <stdexcept>
 #include <string>
 #include <vector>
 
-class Observer
-{
-public:
-    virtual void update(const std::string& event_args) = 0;
-    virtual ~Observer() { }
-};
-
-class TempMonitor
-{
-    int temp_;
-    std::set<std::weak_ptr<Observer>, std::owner_less<std::weak_ptr<Observer>>> observers_;
-
-public:
-    TempMonitor()
-        : temp_(0)
-    {
-    }
-
-    void register_observer(std::weak_ptr<Observer> observer)
-    {
-        observers_.insert(observer);
-    }
-
-    void unregister_observer(std::weak_ptr<Observer> observer)
-    {
-        observers_.erase(observer);
-    }
-
-    void set_temp(int new_temp)
-    {
-        if (temp_ != new_temp)
-        {
-            temp_ = new_temp;
-            notify("Temp changed on: " + std::to_string(temp_));
-        }
-    }
-
-protected:
-    void notify(const std::string& event_args)
-    {
-        for (std::weak_ptr<Observer> observer : observers_)
-        {
-            if (std::shared_ptr<Observer> living_observer = observer.lock(); living_observer)
-                living_observer->update(event_args);
-        }
-    }
-};
-
-class Fan : public Observer
-{
-public:
-    virtual void update(const std::string& event)
-    {
-        std::cout << "Fan is notified: " << event << "\n";
-    }
-};
-
-class Display : public Observer, public std::enable_shared_from_this<Display>
-{
-public:
-    virtual void update(const std::string& event)
-    {
-        std::cout << "Update of display: " << event << std::endl;
-    }
-
-    void register_me_as_observer(TempMonitor& tm)
-    {
-        tm.register_observer(shared_from_this());
-    }
-};
+#include "observers.hpp"
+#include "static_temp_monitor.hpp"
 
 int main(int argc, char const* argv[])
 {
@@ -87,6 +18,9 @@ int main(int argc, char const* argv[])
     std::shared_ptr<Fan> fan = std::make_shared<Fan>();
     temp_monitor.register_observer(fan);
 
+    auto alarm = std::make_shared<Alarm>(1);
+    temp_monitor.register_observer(alarm);
+
     {
         std::shared_ptr<Observer> o = std::make_shared<Display>();
 
@@ -102,6 +36,16 @@ int main(int argc, char const* argv[])
     }
 
     temp_monitor.set_temp(2);
+
+    cout << "\nStaticTempMonitor:\n";
+
+    Fan static_fan;
+    Display static_display;
+    Alarm static_alarm {1};
+
+    StaticTempMonitor static_monitor {static_fan, static_display, static_alarm};
+    static_monitor.set_temp(1);
+    static_monitor.set_temp(2);
 }
 
 namespace explain_shared_from_this
@@ -0,0 +1,54 @@
+#ifndef OBSERVERS_HPP
+#define OBSERVERS_HPP
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "temp_monitor.hpp"
+
+class Fan final : public TextObserver
+{
+public:
+    using TextObserver::update;
+
+    virtual void update(const std::string& event)
+    {
+        std::cout << "Fan is notified: " << event << "\n";
+    }
+};
+
+class Display final : public TextObserver, public std::enable_shared_from_this<Display>
+{
+public:
+    using TextObserver::update;
+
+    virtual void update(const std::string& event)
+    {
+        std::cout << "Update of display: " << event << std::endl;
+    }
+
+    void register_me_as_observer(TempMonitor& tm)
+    {
+        tm.register_observer(shared_from_this());
+    }
+};
+
+class Alarm final : public Observer
+{
+    int max_temp_;
+
+public:
+    explicit Alarm(int max_temp)
+        : max_temp_ {max_temp}
+    {
+    }
+
+    void update(TempChanged event) override
+    {
+        if (event.new_temp > max_temp_ && event.old_temp <= max_temp_)
+            std::cout << "Alarm! Temp is over " << max_temp_ << "\n";
+    }
+};
+
+#endif // OBSERVERS_HPP
@@ -0,0 +1,188 @@
+#ifndef SENSOR_BANK_HPP
+#define SENSOR_BANK_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "temp_monitor.hpp"
+
+namespace SensorScan
+{
+    // appends indexes of sensors where |readings[i] - temps[i]| > thresholds[i] to changed
+    // - valid for any temps & readings (difference is computed without overflow); thresholds must be >= 0
+    inline void scan_changes_scalar(const std::int32_t* temps, const std::int32_t* readings, const std::int32_t* thresholds,
+        std::size_t first, std::size_t last, std::vector<std::uint32_t>& changed)
+    {
+        for (std::size_t i = first; i < last; ++i)
+        {
+            std::int64_t diff = std::int64_t {readings[i]} - temps[i];
+            if ((diff < 0 ? -diff : diff) > thresholds[i])
+                changed.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+
+#ifdef __SSE2__
+    // compares 4 sensors at once - indexes of changed sensors are extracted from the comparison mask
+    inline void scan_changes_sse2(const std::int32_t* temps, const std::int32_t* readings, const std::int32_t* thresholds,
+        std::size_t count, std::vector<std::uint32_t>& changed)
+    {
+        const __m128i sign_bit = _mm_set1_epi32(INT32_MIN);
+        std::size_t i = 0;
+
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i current = _mm_loadu_si128(reinterpret_cast<const __m128i*>(temps + i));
+            __m128i reading = _mm_loadu_si128(reinterpret_cast<const __m128i*>(readings + i));
+            __m128i threshold = _mm_loadu_si128(reinterpret_cast<const __m128i*>(thresholds + i));
+
+            // |reading - current| = max - min is exact as unsigned 32-bit value (SSE2 has no _mm_max_epi32 & _mm_abs_epi32)
+            __m128i is_greater = _mm_cmpgt_epi32(reading, current);
+            __m128i high = _mm_or_si128(_mm_and_si128(is_greater, reading), _mm_andnot_si128(is_greater, current));
+            __m128i low = _mm_or_si128(_mm_and_si128(is_greater, current), _mm_andnot_si128(is_greater, reading));
+            __m128i abs_diff = _mm_sub_epi32(high, low);
+
+            // unsigned comparison - flipped sign bits turn it into the signed one
+            __m128i is_changed = _mm_cmpgt_epi32(_mm_xor_si128(abs_diff, sign_bit), _mm_xor_si128(threshold, sign_bit));
+
+            for (int mask = _mm_movemask_ps(_mm_castsi128_ps(is_changed)); mask != 0; mask &= mask - 1)
+                changed.push_back(static_cast<std::uint32_t>(i + __builtin_ctz(mask)));
+        }
+
+        scan_changes_scalar(temps, readings, thresholds, i, count, changed);
+    }
+#endif
+
+    inline void scan_changes(const std::int32_t* temps, const std::int32_t* readings, const std::int32_t* thresholds,
+        std::size_t count, std::vector<std::uint32_t>& changed)
+    {
+#ifdef __SSE2__
+        scan_changes_sse2(temps, readings, thresholds, count, changed);
+#else
+        scan_changes_scalar(temps, readings, thresholds, 0, count, changed);
+#endif
+    }
+}
+
+/////////////////////////////////////////////////////////////////
+// Bank of sensors - replaces one TempMonitor per sensor
+// - temperatures & thresholds are stored in contiguous arrays (structure of arrays)
+// - a sensor is changed when reading differs from the current temp by more than its threshold
+// - readings of all sensors are applied in batches: changed sensors are found first,
+//   then only their observers are notified
+// - not thread-safe: updates & registration of observers must be serialized by the caller
+//
+class TempSensorBank
+{
+    std::vector<std::int32_t> temps_;
+    std::vector<std::int32_t> thresholds_;
+    std::vector<std::uint32_t> changed_;
+    std::vector<std::int32_t> previous_temps_; // of changed sensors
+    std::unordered_map<std::uint32_t, ObserverRegistry> observers_; // only sensors with observers
+
+public:
+    explicit TempSensorBank(std::size_t sensors_count, int initial_temp = 0, int threshold = 0)
+        : temps_(sensors_count, initial_temp)
+        , thresholds_(sensors_count, threshold)
+    {
+        check_threshold(threshold);
+
+        changed_.reserve(sensors_count);
+        previous_temps_.reserve(sensors_count);
+    }
+
+    std::size_t size() const
+    {
+        return temps_.size();
+    }
+
+    int temp(std::size_t sensor) const
+    {
+        return temps_.at(sensor);
+    }
+
+    void set_threshold(std::size_t sensor, int threshold)
+    {
+        check_threshold(threshold);
+        thresholds_.at(sensor) = threshold;
+    }
+
+    void register_observer(std::size_t sensor, std::weak_ptr<Observer> observer)
+    {
+        check_sensor(sensor);
+
+        observers_.emplace(std::piecewise_construct, std::forward_as_tuple(static_cast<std::uint32_t>(sensor)), std::tuple<> {})
+            .first->second.add(std::move(observer));
+    }
+
+    void unregister_observer(std::size_t sensor, std::weak_ptr<Observer> observer)
+    {
+        if (auto it = observers_.find(static_cast<std::uint32_t>(sensor)); it != observers_.end())
+            it->second.remove(observer);
+    }
+
+    // readings[i] is a new reading of i-th sensor; returns indexes of changed sensors
+    const std::vector<std::uint32_t>& update(const std::vector<int>& readings)
+    {
+        if (readings.size() != temps_.size())
+            throw std::invalid_argument("Number of readings doesn't match number of sensors");
+
+        static_assert(sizeof(int) == sizeof(std::int32_t));
+
+        changed_.clear();
+        SensorScan::scan_changes(temps_.data(), readings.data(), thresholds_.data(), temps_.size(), changed_);
+
+        previous_temps_.clear();
+        for (std::uint32_t sensor : changed_)
+        {
+            previous_temps_.push_back(temps_[sensor]);
+            temps_[sensor] = readings[sensor];
+        }
+
+        notify_changed();
+
+        return changed_;
+    }
+
+private:
+    void check_sensor(std::size_t sensor) const
+    {
+        if (sensor >= temps_.size())
+            throw std::out_of_range("Invalid sensor index");
+    }
+
+    static void check_threshold(int threshold)
+    {
+        if (threshold < 0)
+            throw std::invalid_argument("Threshold must not be negative");
+    }
+
+    void notify_changed()
+    {
+        if (observers_.empty())
+            return;
+
+        auto timestamp = std::chrono::steady_clock::now();
+
+        for (std::size_t i = 0; i < changed_.size(); ++i)
+        {
+            if (auto it = observers_.find(changed_[i]); it != observers_.end())
+            {
+                TempChanged event {previous_temps_[i], temps_[changed_[i]], timestamp};
+                it->second.for_each_alive([&event](Observer& observer) { observer.update(event); });
+            }
+        }
+    }
+};
+
+#endif // SENSOR_BANK_HPP
@@ -0,0 +1,52 @@
+#ifndef STATIC_TEMP_MONITOR_HPP
+#define STATIC_TEMP_MONITOR_HPP
+
+#include <chrono>
+#include <tuple>
+
+#include "temp_monitor.hpp"
+
+/////////////////////////////////////////////////////////////////
+// Monitor with a set of observers known at compile time
+// - observers are held by reference - they must outlive the monitor
+// - update() is called through the static type of an observer, so calls to final observers
+//   are devirtualized & may be inlined
+// - text observers must bring the typed overload with `using TextObserver::update;` -
+//   otherwise it is hidden by update(const std::string&)
+// - not thread-safe
+//
+template <typename... Observers>
+class StaticTempMonitor
+{
+    int temp_ = 0;
+    std::tuple<Observers&...> observers_;
+
+public:
+    explicit StaticTempMonitor(Observers&... observers)
+        : observers_ {observers...}
+    {
+    }
+
+    int temp() const
+    {
+        return temp_;
+    }
+
+    void set_temp(int new_temp)
+    {
+        if (temp_ != new_temp)
+        {
+            TempChanged event {temp_, new_temp, std::chrono::steady_clock::now()};
+            temp_ = new_temp;
+            notify(event);
+        }
+    }
+
+protected:
+    void notify(TempChanged event)
+    {
+        std::apply([&event](Observers&... observers) { (observers.update(event), ...); }, observers_);
+    }
+};
+
+#endif // STATIC_TEMP_MONITOR_HPP
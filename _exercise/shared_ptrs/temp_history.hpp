@@ -0,0 +1,411 @@
+#ifndef TEMP_HISTORY_HPP
+#define TEMP_HISTORY_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "temp_monitor.hpp"
+
+// wall clock - persisted history must survive restarts of the process
+using HistoryClock = std::chrono::system_clock;
+
+struct TempSample
+{
+    std::int64_t timestamp_ns; // since epoch of HistoryClock
+    std::int32_t temp;
+};
+
+struct TempAggregate
+{
+    std::int64_t start_ns; // start of the period
+    std::int32_t min;
+    std::int32_t max;
+    std::int64_t sum;
+    std::uint32_t count;
+
+    double average() const
+    {
+        return count ? static_cast<double>(sum) / count : 0.0;
+    }
+};
+
+namespace History
+{
+    /////////////////////////////////////////////////////////////////
+    // Lock-free ring buffer - one writer, many readers
+    // - items are stored as relaxed atomic words, so readers may race with the writer
+    // - the writer announces an overwrite (writing) before it touches a slot & commits it (head) afterwards;
+    //   a reader validates every item it has read against writing (seqlock) & skips overwritten ones
+    // - works on external storage (heap or memory mapped file) - state is resumed if storage is already initialized
+    //
+    template <typename T>
+    class SeqRing
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        using Word = std::atomic<std::uint64_t>;
+        static constexpr std::size_t words_per_item = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+        static constexpr std::uint64_t magic = 0x5445'4d50'4849'5354; // "TEMPHIST"
+
+        struct Header
+        {
+            std::uint64_t magic;
+            std::uint64_t item_size;
+            std::uint64_t capacity;
+            Word writing; // index of the last item whose write has started + 1
+            Word head; // number of committed items
+        };
+
+        Header* header_;
+        Word* words_;
+        std::uint64_t capacity_;
+
+    public:
+        static std::size_t storage_size(std::size_t capacity)
+        {
+            return sizeof(Header) + capacity * words_per_item * sizeof(Word);
+        }
+
+        SeqRing(void* storage, std::size_t capacity)
+            : header_ {static_cast<Header*>(storage)}
+            , words_ {reinterpret_cast<Word*>(static_cast<std::byte*>(storage) + sizeof(Header))}
+            , capacity_ {capacity}
+        {
+            if (header_->magic != magic || header_->item_size != sizeof(T) || header_->capacity != capacity)
+            {
+                new (header_) Header {magic, sizeof(T), capacity, {0}, {0}};
+                std::uninitialized_fill_n(words_, capacity * words_per_item, 0); // atomic words are constructed in raw storage
+            }
+            // if the writer was interrupted during a write, writing stays ahead of head -
+            // the half-written slot remains invalid until it is written again
+        }
+
+        SeqRing(const SeqRing&) = delete;
+        SeqRing& operator=(const SeqRing&) = delete;
+
+        std::size_t capacity() const
+        {
+            return capacity_;
+        }
+
+        // number of items ever written
+        std::uint64_t head() const
+        {
+            return header_->head.load(std::memory_order_acquire);
+        }
+
+        // called by the writer only
+        void push(const T& item)
+        {
+            std::uint64_t index = header_->head.load(std::memory_order_relaxed);
+
+            header_->writing.store(index + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            std::uint64_t buffer[words_per_item] = {};
+            std::memcpy(buffer, &item, sizeof(T));
+            Word* slot = words_ + (index % capacity_) * words_per_item;
+            for (std::size_t i = 0; i < words_per_item; ++i)
+                slot[i].store(buffer[i], std::memory_order_relaxed);
+
+            header_->head.store(index + 1, std::memory_order_release);
+        }
+
+        // returns false if item with the index has been overwritten (or not written yet)
+        bool read(std::uint64_t index, T& item) const
+        {
+            if (index >= head())
+                return false;
+
+            std::uint64_t buffer[words_per_item];
+            const Word* slot = words_ + (index % capacity_) * words_per_item;
+            for (std::size_t i = 0; i < words_per_item; ++i)
+                buffer[i] = slot[i].load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (header_->writing.load(std::memory_order_relaxed) > index + capacity_)
+                return false;
+
+            std::memcpy(&item, buffer, sizeof(T));
+            return true;
+        }
+
+        // index of the oldest item that is still stored
+        std::uint64_t tail() const
+        {
+            std::uint64_t written = head();
+            return written > capacity_ ? written - capacity_ : 0;
+        }
+    };
+
+    /////////////////////////////////////////////////////////////////
+    // Storage of the rings in a memory mapped file
+    //
+    class MappedStorage
+    {
+        void* address_ = nullptr;
+        std::size_t size_ = 0;
+
+    public:
+        MappedStorage(const std::string& path, std::size_t size)
+            : size_ {size}
+        {
+            int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+            if (fd == -1)
+                throw std::system_error(errno, std::generic_category(), "Cannot open history file " + path);
+
+            if (::ftruncate(fd, static_cast<off_t>(size)) == -1)
+            {
+                int error = errno;
+                ::close(fd);
+                throw std::system_error(error, std::generic_category(), "Cannot resize history file " + path);
+            }
+
+            address_ = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            int error = errno;
+            ::close(fd); // mapping stays valid after closing the descriptor
+
+            if (address_ == MAP_FAILED)
+                throw std::system_error(error, std::generic_category(), "Cannot map history file " + path);
+        }
+
+        MappedStorage(const MappedStorage&) = delete;
+        MappedStorage& operator=(const MappedStorage&) = delete;
+
+        ~MappedStorage()
+        {
+            ::munmap(address_, size_);
+        }
+
+        void* data() const
+        {
+            return address_;
+        }
+    };
+}
+
+struct HistoryOptions
+{
+    std::size_t raw_capacity = 4096; // samples
+    std::size_t seconds_capacity = 3600; // 1 s aggregates - last hour
+    std::size_t minutes_capacity = 1440; // 1 min aggregates - last day
+};
+
+enum class HistoryTier
+{
+    seconds,
+    minutes
+};
+
+/////////////////////////////////////////////////////////////////
+// Fixed-memory history of temperatures
+// - raw samples + tiers of downsampled aggregates (1 s, 1 min)
+// - record() must be called from one thread only; queries are lock-free & may run concurrently
+// - tiers contain completed periods only
+// - optionally persisted in a memory mapped file
+//
+class TempHistory
+{
+    class Tier
+    {
+        History::SeqRing<TempAggregate> ring_;
+        std::int64_t period_ns_;
+        TempAggregate current_ {};
+
+    public:
+        Tier(void* storage, std::size_t capacity, std::chrono::nanoseconds period)
+            : ring_ {storage, capacity}
+            , period_ns_ {period.count()}
+        {
+        }
+
+        void add(const TempSample& sample)
+        {
+            std::int64_t start = sample.timestamp_ns - sample.timestamp_ns % period_ns_;
+
+            if (current_.count != 0 && current_.start_ns != start)
+            {
+                ring_.push(current_);
+                current_.count = 0;
+            }
+
+            if (current_.count == 0)
+                current_ = TempAggregate {start, sample.temp, sample.temp, 0, 0};
+
+            current_.min = std::min(current_.min, sample.temp);
+            current_.max = std::max(current_.max, sample.temp);
+            current_.sum += sample.temp;
+            ++current_.count;
+        }
+
+        const History::SeqRing<TempAggregate>& ring() const
+        {
+            return ring_;
+        }
+    };
+
+    std::unique_ptr<std::uint64_t[]> heap_storage_;
+    std::unique_ptr<History::MappedStorage> mapped_storage_;
+    History::SeqRing<TempSample> raw_;
+    Tier seconds_;
+    Tier minutes_;
+
+public:
+    explicit TempHistory(const HistoryOptions& options = {})
+        : TempHistory {options, allocate(options)}
+    {
+    }
+
+    // history is stored in (and resumed from) the file
+    TempHistory(const std::string& path, const HistoryOptions& options = {})
+        : TempHistory {options, std::make_unique<History::MappedStorage>(path, storage_size(options))}
+    {
+    }
+
+    void record(int temp, HistoryClock::time_point timestamp = HistoryClock::now())
+    {
+        TempSample sample {std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp.time_since_epoch()).count(), temp};
+
+        raw_.push(sample);
+        seconds_.add(sample);
+        minutes_.add(sample);
+    }
+
+    std::uint64_t samples_count() const
+    {
+        return raw_.head();
+    }
+
+    // calls f(const TempSample&) for stored samples from [from, to] in chronological order
+    template <typename F>
+    void visit(HistoryClock::time_point from, HistoryClock::time_point to, F f) const
+    {
+        visit_window(raw_, to_ns(from), to_ns(to), [](const TempSample& s) { return s.timestamp_ns; }, f);
+    }
+
+    // calls f(const TempAggregate&) for completed periods starting in [from, to] in chronological order
+    template <typename F>
+    void visit(HistoryTier tier, HistoryClock::time_point from, HistoryClock::time_point to, F f) const
+    {
+        const auto& ring = (tier == HistoryTier::seconds ? seconds_ : minutes_).ring();
+        visit_window(ring, to_ns(from), to_ns(to), [](const TempAggregate& a) { return a.start_ns; }, f);
+    }
+
+private:
+    TempHistory(const HistoryOptions& options, std::unique_ptr<std::uint64_t[]> storage)
+        : heap_storage_ {std::move(storage)}
+        , raw_ {heap_storage_.get(), options.raw_capacity}
+        , seconds_ {tier_storage(heap_storage_.get(), options, 1), options.seconds_capacity, std::chrono::seconds(1)}
+        , minutes_ {tier_storage(heap_storage_.get(), options, 2), options.minutes_capacity, std::chrono::minutes(1)}
+    {
+    }
+
+    TempHistory(const HistoryOptions& options, std::unique_ptr<History::MappedStorage> storage)
+        : mapped_storage_ {std::move(storage)}
+        , raw_ {mapped_storage_->data(), options.raw_capacity}
+        , seconds_ {tier_storage(mapped_storage_->data(), options, 1), options.seconds_capacity, std::chrono::seconds(1)}
+        , minutes_ {tier_storage(mapped_storage_->data(), options, 2), options.minutes_capacity, std::chrono::minutes(1)}
+    {
+    }
+
+    static std::size_t storage_size(const HistoryOptions& options)
+    {
+        return History::SeqRing<TempSample>::storage_size(options.raw_capacity)
+            + History::SeqRing<TempAggregate>::storage_size(options.seconds_capacity)
+            + History::SeqRing<TempAggregate>::storage_size(options.minutes_capacity);
+    }
+
+    static std::unique_ptr<std::uint64_t[]> allocate(const HistoryOptions& options)
+    {
+        return std::make_unique<std::uint64_t[]>(storage_size(options) / sizeof(std::uint64_t));
+    }
+
+    // storage of consecutive tiers is placed after the raw samples
+    static void* tier_storage(void* storage, const HistoryOptions& options, int tier)
+    {
+        std::size_t offset = History::SeqRing<TempSample>::storage_size(options.raw_capacity);
+        if (tier == 2)
+            offset += History::SeqRing<TempAggregate>::storage_size(options.seconds_capacity);
+
+        return static_cast<std::byte*>(storage) + offset;
+    }
+
+    static std::int64_t to_ns(HistoryClock::time_point time_point)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(time_point.time_since_epoch()).count();
+    }
+
+    // items are ordered by time - the start of the window is found by walking back from the newest item
+    template <typename T, typename TimeOf, typename F>
+    static void visit_window(const History::SeqRing<T>& ring, std::int64_t from, std::int64_t to, TimeOf time_of, F& f)
+    {
+        std::uint64_t first = ring.head();
+        std::uint64_t tail = ring.tail();
+
+        T item;
+        while (first > tail && ring.read(first - 1, item) && time_of(item) >= from)
+            --first;
+
+        for (std::uint64_t index = first;; ++index)
+        {
+            if (!ring.read(index, item))
+            {
+                if (index >= ring.head())
+                    break; // end of history
+
+                // overwritten by the writer - retry the slot that is being written right now
+                // or continue from the oldest stored item
+                index = std::max(index, ring.tail()) - 1;
+                continue;
+            }
+
+            if (time_of(item) > to)
+                break;
+            if (time_of(item) >= from)
+                f(item);
+        }
+    }
+};
+
+/////////////////////////////////////////////////////////////////
+// Records temperatures reported by TempMonitor in the history
+// - history allows one writer only: if set_temp() is called from many threads,
+//   the recorder should be registered with register_async_observer() (deliveries are serialized)
+//
+class HistoryRecorder : public Observer
+{
+    std::shared_ptr<TempHistory> history_;
+
+public:
+    explicit HistoryRecorder(std::shared_ptr<TempHistory> history)
+        : history_ {std::move(history)}
+    {
+    }
+
+    void update(TempChanged event) override
+    {
+        history_->record(event.new_temp);
+    }
+
+    const TempHistory& history() const
+    {
+        return *history_;
+    }
+};
+
+#endif // TEMP_HISTORY_HPP
@@ -0,0 +1,244 @@
+#ifndef TEMP_MONITOR_HPP
+#define TEMP_MONITOR_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct TempChanged
+{
+    int old_temp;
+    int new_temp;
+    std::chrono::steady_clock::time_point timestamp;
+};
+
+inline std::string to_string(const TempChanged& event)
+{
+    return "Temp changed on: " + std::to_string(event.new_temp);
+}
+
+class Observer
+{
+public:
+    virtual void update(TempChanged event) = 0;
+    virtual ~Observer() { }
+};
+
+/////////////////////////////////////////////////////////////////
+// Observer notified with a text description of the event
+// - text is formatted only for observers that need it
+//
+class TextObserver : public Observer
+{
+public:
+    void update(TempChanged event) override
+    {
+        update(to_string(event));
+    }
+
+    virtual void update(const std::string& event_args) = 0;
+};
+
+/////////////////////////////////////////////////////////////////
+// Observer that forwards notifications to another observer (queueing, filtering, etc.)
+//
+class NotificationForwarder : public Observer
+{
+public:
+    // delivers values held back by the forwarder - called periodically by TempMonitor::flush_pending()
+    virtual void flush_pending(std::chrono::steady_clock::time_point /*now*/) { }
+};
+
+/////////////////////////////////////////////////////////////////
+// Thread-safe registry of observers (copy-on-write)
+// - observers are stored in a contiguous vector that is never modified after publication
+// - notification iterates a snapshot of the list - no locks are held while observers are called,
+//   so observers may register or unregister (themselves or others) inside update()
+// - registration copies the list & atomically publishes the new version
+// - expired observers are removed in batches after notification
+// - notifications may be routed through a forwarder (e.g. an asynchronous channel)
+//   that is owned by the registry as long as the observer is registered
+//
+class ObserverRegistry
+{
+    struct Entry
+    {
+        std::weak_ptr<Observer> observer;
+        std::shared_ptr<NotificationForwarder> forwarder;
+    };
+
+    using ObserverList = std::vector<Entry>;
+
+    std::shared_ptr<const ObserverList> observers_ = std::make_shared<const ObserverList>();
+    std::mutex writer_mtx_; // serializes modifications of the list
+
+    static constexpr std::size_t compaction_batch = 16;
+
+public:
+    ObserverRegistry() = default;
+    ObserverRegistry(const ObserverRegistry&) = delete;
+    ObserverRegistry& operator=(const ObserverRegistry&) = delete;
+
+    // returns false if observer is already registered
+    bool add(std::weak_ptr<Observer> observer, std::shared_ptr<NotificationForwarder> forwarder = nullptr)
+    {
+        std::lock_guard lk {writer_mtx_};
+
+        auto current = snapshot();
+        if (find(*current, observer) != current->end())
+            return false;
+
+        auto updated = std::make_shared<ObserverList>();
+        updated->reserve(current->size() + 1);
+        updated->assign(current->begin(), current->end());
+        updated->push_back(Entry {std::move(observer), std::move(forwarder)});
+        publish(std::move(updated));
+
+        return true;
+    }
+
+    bool remove(const std::weak_ptr<Observer>& observer)
+    {
+        std::lock_guard lk {writer_mtx_};
+
+        auto current = snapshot();
+        auto it = find(*current, observer);
+        if (it == current->end())
+            return false;
+
+        auto updated = std::make_shared<ObserverList>(current->begin(), it);
+        updated->insert(updated->end(), std::next(it), current->end());
+        publish(std::move(updated));
+
+        return true;
+    }
+
+    std::size_t size() const
+    {
+        return snapshot()->size();
+    }
+
+    template <typename F>
+    void for_each_alive(F f)
+    {
+        std::shared_ptr<const ObserverList> observers = snapshot();
+        std::size_t expired_count = 0;
+
+        for (const Entry& entry : *observers)
+        {
+            if (std::shared_ptr<Observer> living_observer = entry.observer.lock(); living_observer)
+                f(entry.forwarder ? static_cast<Observer&>(*entry.forwarder) : *living_observer);
+            else
+                ++expired_count;
+        }
+
+        if (expired_count >= compaction_batch || (expired_count > 0 && expired_count * 4 >= observers->size()))
+            remove_expired();
+    }
+
+    template <typename F>
+    void for_each_forwarder(F f)
+    {
+        std::shared_ptr<const ObserverList> observers = snapshot();
+
+        for (const Entry& entry : *observers)
+        {
+            if (entry.forwarder && !entry.observer.expired())
+                f(*entry.forwarder);
+        }
+    }
+
+    void remove_expired()
+    {
+        std::lock_guard lk {writer_mtx_};
+
+        auto current = snapshot();
+        auto updated = std::make_shared<ObserverList>();
+        updated->reserve(current->size());
+        std::copy_if(current->begin(), current->end(), std::back_inserter(*updated), [](const Entry& entry) { return !entry.observer.expired(); });
+        publish(std::move(updated));
+    }
+
+private:
+    std::shared_ptr<const ObserverList> snapshot() const
+    {
+        return std::atomic_load(&observers_);
+    }
+
+    void publish(std::shared_ptr<const ObserverList> observers)
+    {
+        std::atomic_store(&observers_, std::move(observers));
+    }
+
+    static ObserverList::const_iterator find(const ObserverList& observers, const std::weak_ptr<Observer>& observer)
+    {
+        return std::find_if(observers.begin(), observers.end(), [&observer](const Entry& entry) {
+            return !entry.observer.owner_before(observer) && !observer.owner_before(entry.observer);
+        });
+    }
+};
+
+/////////////////////////////////////////////////////////////////
+// set_temp() may be called concurrently from many threads
+// - events from different threads may be delivered in any order
+//
+class TempMonitor
+{
+    std::atomic<int> temp_;
+    ObserverRegistry observers_;
+
+public:
+    TempMonitor()
+        : temp_(0)
+    {
+    }
+
+    void register_observer(std::weak_ptr<Observer> observer)
+    {
+        observers_.add(std::move(observer));
+    }
+
+    // notifications for observer are delivered by calling forwarder->update()
+    void register_observer(std::weak_ptr<Observer> observer, std::shared_ptr<NotificationForwarder> forwarder)
+    {
+        observers_.add(std::move(observer), std::move(forwarder));
+    }
+
+    void unregister_observer(std::weak_ptr<Observer> observer)
+    {
+        observers_.remove(observer);
+    }
+
+    int temp() const
+    {
+        return temp_.load();
+    }
+
+    void set_temp(int new_temp)
+    {
+        if (int old_temp = temp_.exchange(new_temp); old_temp != new_temp)
+            notify(TempChanged {old_temp, new_temp, std::chrono::steady_clock::now()});
+    }
+
+    // delivers notifications held back by forwarders (e.g. trailing values of coalescing observers)
+    void flush_pending()
+    {
+        auto now = std::chrono::steady_clock::now();
+        observers_.for_each_forwarder([now](NotificationForwarder& forwarder) { forwarder.flush_pending(now); });
+    }
+
+protected:
+    void notify(TempChanged event)
+    {
+        observers_.for_each_alive([event](Observer& observer) { observer.update(event); });
+    }
+};
+
+#endif // TEMP_MONITOR_HPP
@@ -0,0 +1,320 @@
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "async_dispatch.hpp"
+#include "catch.hpp"
+
+namespace
+{
+    // blocks in update() for any of the gate temps until the gate is opened
+    class GatedObserver : public Observer
+    {
+        std::mutex mtx_;
+        std::condition_variable cv_;
+        const std::vector<int> gates_;
+        std::vector<int> entered_;
+        std::vector<int> opened_;
+        std::vector<int> temps_;
+
+        static bool contains(const std::vector<int>& temps, int temp)
+        {
+            return std::find(temps.begin(), temps.end(), temp) != temps.end();
+        }
+
+    public:
+        explicit GatedObserver(std::vector<int> gates = {1})
+            : gates_ {std::move(gates)}
+        {
+        }
+
+        void update(TempChanged event) override
+        {
+            std::unique_lock lk {mtx_};
+            temps_.push_back(event.new_temp);
+
+            if (contains(gates_, event.new_temp))
+            {
+                entered_.push_back(event.new_temp);
+                cv_.notify_all();
+                cv_.wait(lk, [&] { return contains(opened_, event.new_temp); });
+            }
+        }
+
+        void wait_until_entered(int gate = 1)
+        {
+            std::unique_lock lk {mtx_};
+            cv_.wait(lk, [&] { return contains(entered_, gate); });
+        }
+
+        void open(int gate = 1)
+        {
+            {
+                std::lock_guard lk {mtx_};
+                opened_.push_back(gate);
+            }
+            cv_.notify_all();
+        }
+
+        std::vector<int> temps()
+        {
+            std::lock_guard lk {mtx_};
+            return temps_;
+        }
+    };
+
+    class OrderCheckingObserver : public Observer
+    {
+    public:
+        int last_temp = 0;
+        int count = 0;
+        bool in_order = true;
+
+        void update(TempChanged event) override
+        {
+            in_order = in_order && event.new_temp > last_temp && event.old_temp == last_temp;
+            last_temp = event.new_temp;
+            ++count;
+        }
+    };
+
+    class SlowDisplay : public Observer
+    {
+    public:
+        long count = 0;
+        bool in_order = true;
+        int last_temp = 0;
+
+        void update(TempChanged event) override
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+
+            in_order = in_order && event.new_temp > last_temp;
+            last_temp = event.new_temp;
+            ++count;
+        }
+    };
+
+    std::string to_string(OverflowPolicy policy)
+    {
+        switch (policy)
+        {
+        case OverflowPolicy::drop_oldest:
+            return "drop_oldest";
+        case OverflowPolicy::drop_newest:
+            return "drop_newest";
+        case OverflowPolicy::block:
+            return "block";
+        }
+        return "";
+    }
+}
+
+TEST_CASE("async dispatch - overflow policies")
+{
+    using namespace Catch::Matchers;
+
+    constexpr std::size_t capacity = 4;
+
+    auto observer = std::make_shared<GatedObserver>();
+    std::shared_ptr<const AsyncChannel> channel;
+
+    SECTION("drop_oldest")
+    {
+        {
+            AsyncDispatcher dispatcher {1};
+            TempMonitor monitor;
+            channel = register_async_observer(monitor, observer, dispatcher, DispatchOptions {capacity, OverflowPolicy::drop_oldest});
+
+            monitor.set_temp(1);
+            observer->wait_until_entered(); // worker is blocked with 1st event - queue is empty
+
+            for (int temp = 2; temp <= 11; ++temp)
+                monitor.set_temp(temp);
+
+            LagMetrics metrics = channel->metrics();
+            REQUIRE(metrics.enqueued == 11);
+            REQUIRE(metrics.dropped == 6);
+            REQUIRE(metrics.depth == capacity);
+            REQUIRE(metrics.max_depth == capacity);
+
+            observer->open();
+        } // pending events are delivered before dispatcher is destroyed
+
+        REQUIRE_THAT(observer->temps(), Equals(std::vector<int> {1, 8, 9, 10, 11}));
+        REQUIRE(channel->metrics().delivered == 5);
+        REQUIRE(channel->metrics().depth == 0);
+    }
+
+    SECTION("drop_newest")
+    {
+        {
+            AsyncDispatcher dispatcher {1};
+            TempMonitor monitor;
+            channel = register_async_observer(monitor, observer, dispatcher, DispatchOptions {capacity, OverflowPolicy::drop_newest});
+
+            monitor.set_temp(1);
+            observer->wait_until_entered();
+
+            for (int temp = 2; temp <= 11; ++temp)
+                monitor.set_temp(temp);
+
+            LagMetrics metrics = channel->metrics();
+            REQUIRE(metrics.enqueued == 5);
+            REQUIRE(metrics.dropped == 6);
+            REQUIRE(metrics.depth == capacity);
+
+            observer->open();
+        }
+
+        REQUIRE_THAT(observer->temps(), Equals(std::vector<int> {1, 2, 3, 4, 5}));
+        REQUIRE(channel->metrics().delivered == 5);
+    }
+
+    SECTION("block")
+    {
+        {
+            AsyncDispatcher dispatcher {1};
+            TempMonitor monitor;
+            channel = register_async_observer(monitor, observer, dispatcher, DispatchOptions {capacity, OverflowPolicy::block});
+
+            monitor.set_temp(1);
+            observer->wait_until_entered();
+
+            std::thread sensor {[&monitor] {
+                for (int temp = 2; temp <= 11; ++temp)
+                    monitor.set_temp(temp); // blocks when queue is full
+            }};
+
+            observer->open();
+            sensor.join();
+        }
+
+        REQUIRE_THAT(observer->temps(), Equals(std::vector<int> {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11}));
+
+        LagMetrics metrics = channel->metrics();
+        REQUIRE(metrics.enqueued == 11);
+        REQUIRE(metrics.delivered == 11);
+        REQUIRE(metrics.dropped == 0);
+        REQUIRE(metrics.max_depth <= capacity);
+    }
+}
+
+TEST_CASE("async dispatch - queue is bounded while observer is in the middle of a batch")
+{
+    using namespace Catch::Matchers;
+
+    constexpr std::size_t capacity = 4;
+
+    auto observer = std::make_shared<GatedObserver>(std::vector<int> {1, 3});
+    std::shared_ptr<const AsyncChannel> channel;
+
+    {
+        AsyncDispatcher dispatcher {1};
+        TempMonitor monitor;
+        channel = register_async_observer(monitor, observer, dispatcher, DispatchOptions {capacity, OverflowPolicy::drop_newest});
+
+        monitor.set_temp(1);
+        observer->wait_until_entered(1);
+
+        for (int temp = 2; temp <= 5; ++temp)
+            monitor.set_temp(temp); // queue is full: 2, 3, 4, 5
+
+        observer->open(1);
+        observer->wait_until_entered(3); // 4 & 5 are still waiting in the queue
+
+        for (int temp = 6; temp <= 13; ++temp)
+            monitor.set_temp(temp);
+
+        LagMetrics metrics = channel->metrics(); // CHECK - the gate must be opened even if it fails
+        CHECK(metrics.depth == capacity);
+        CHECK(metrics.delivered == 2);
+        CHECK(metrics.enqueued - metrics.delivered == capacity + 1); // queue + event being delivered
+        CHECK(metrics.dropped == 6);
+
+        observer->open(3);
+    }
+
+    REQUIRE_THAT(observer->temps(), Equals(std::vector<int> {1, 2, 3, 4, 5, 6, 7}));
+    REQUIRE(channel->metrics().max_depth == capacity);
+}
+
+TEST_CASE("async dispatch - events are delivered to every observer in order")
+{
+    constexpr int updates_count = 10'000;
+
+    std::vector<std::shared_ptr<OrderCheckingObserver>> observers;
+    std::vector<std::shared_ptr<const AsyncChannel>> channels;
+
+    {
+        AsyncDispatcher dispatcher {4};
+        TempMonitor monitor;
+
+        for (int i = 0; i < 8; ++i)
+        {
+            observers.push_back(std::make_shared<OrderCheckingObserver>());
+            channels.push_back(register_async_observer(monitor, observers.back(), dispatcher, DispatchOptions {16, OverflowPolicy::block}));
+        }
+
+        for (int temp = 1; temp <= updates_count; ++temp)
+            monitor.set_temp(temp);
+    }
+
+    for (std::size_t i = 0; i < observers.size(); ++i)
+    {
+        REQUIRE(observers[i]->in_order);
+        REQUIRE(observers[i]->count == updates_count);
+        REQUIRE(channels[i]->metrics().delivered == updates_count);
+    }
+}
+
+TEST_CASE("async dispatch - set_temp() with slow observer", "[.][benchmark]")
+{
+    {
+        TempMonitor monitor;
+        auto display = std::make_shared<SlowDisplay>();
+        monitor.register_observer(display);
+
+        int temp = 0;
+        BENCHMARK("set_temp: synchronous slow observer")
+        {
+            monitor.set_temp(++temp);
+            return temp;
+        };
+    }
+
+    for (OverflowPolicy policy : {OverflowPolicy::drop_oldest, OverflowPolicy::drop_newest, OverflowPolicy::block})
+    {
+        auto display = std::make_shared<SlowDisplay>();
+        std::shared_ptr<const AsyncChannel> channel;
+
+        {
+            AsyncDispatcher dispatcher {2};
+            TempMonitor monitor;
+            channel = register_async_observer(monitor, display, dispatcher, DispatchOptions {256, policy});
+
+            int temp = 0;
+            BENCHMARK("set_temp: asynchronous slow observer - " + to_string(policy))
+            {
+                monitor.set_temp(++temp);
+                return temp;
+            };
+        } // dispatcher drains pending events
+
+        LagMetrics metrics = channel->metrics();
+        std::cout << to_string(policy) << " - enqueued: " << metrics.enqueued
+                  << ", delivered: " << metrics.delivered
+                  << ", dropped: " << metrics.dropped
+                  << ", max depth: " << metrics.max_depth
+                  << ", max latency: " << std::chrono::duration_cast<std::chrono::microseconds>(metrics.max_latency).count() << " us\n";
+
+        CHECK(display->in_order);
+        CHECK(metrics.max_depth <= 256);
+    }
+}
@@ -0,0 +1,194 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "catch.hpp"
+#include "coalescing.hpp"
+
+namespace
+{
+    class RecordingObserver : public Observer
+    {
+    public:
+        std::vector<TempChanged> events;
+
+        void update(TempChanged event) override
+        {
+            events.push_back(event);
+        }
+    };
+
+    class FlushCountingForwarder : public NotificationForwarder
+    {
+    public:
+        int flushes = 0;
+
+        void update(TempChanged) override
+        {
+        }
+
+        void flush_pending(std::chrono::steady_clock::time_point) override
+        {
+            ++flushes;
+        }
+    };
+
+    class CountingDisplay : public Observer
+    {
+    public:
+        std::atomic<long> count {0};
+        std::atomic<int> last_temp {0};
+
+        void update(TempChanged event) override
+        {
+            last_temp = event.new_temp;
+            ++count;
+        }
+    };
+}
+
+TEST_CASE("coalescing observer")
+{
+    using namespace std::chrono_literals;
+
+    TempMonitor monitor;
+    auto display = std::make_shared<RecordingObserver>();
+    auto filter = std::make_shared<CoalescingFilter>(display, CoalescingOptions {1h, 1});
+    monitor.register_observer(display, filter);
+
+    monitor.set_temp(20);
+    REQUIRE(display->events.size() == 1);
+
+    SECTION("changes within hysteresis are ignored")
+    {
+        monitor.set_temp(21);
+        monitor.set_temp(19);
+
+        filter->flush_pending(std::chrono::steady_clock::now() + 2h);
+
+        REQUIRE(display->events.size() == 1);
+    }
+
+    SECTION("only the latest value is delivered after min_interval")
+    {
+        monitor.set_temp(25);
+        monitor.set_temp(26);
+        monitor.set_temp(27);
+        REQUIRE(display->events.size() == 1);
+
+        filter->flush_pending(std::chrono::steady_clock::now());
+        REQUIRE(display->events.size() == 1);
+
+        filter->flush_pending(std::chrono::steady_clock::now() + 2h);
+        REQUIRE(display->events.size() == 2);
+        REQUIRE(display->events.back().old_temp == 20);
+        REQUIRE(display->events.back().new_temp == 27);
+
+        REQUIRE(filter->stats().received == 4);
+        REQUIRE(filter->stats().delivered == 2);
+    }
+
+    SECTION("pending value is dropped when temp returns within hysteresis")
+    {
+        monitor.set_temp(25);
+        monitor.set_temp(20);
+
+        filter->flush_pending(std::chrono::steady_clock::now() + 2h);
+
+        REQUIRE(display->events.size() == 1);
+    }
+}
+
+TEST_CASE("coalescing observer - concurrent update() & flush_pending()")
+{
+    using namespace std::chrono_literals;
+
+    constexpr int updates_count = 20'000;
+
+    TempMonitor monitor;
+    auto display = std::make_shared<RecordingObserver>();
+    auto filter = std::make_shared<CoalescingFilter>(display, CoalescingOptions {1us, 0});
+    monitor.register_observer(display, filter);
+
+    std::atomic<bool> done {false};
+    std::thread flushing_thread {[&] {
+        while (!done)
+            monitor.flush_pending();
+    }};
+
+    for (int temp = 1; temp <= updates_count; ++temp)
+        monitor.set_temp(temp);
+
+    done = true;
+    flushing_thread.join();
+    filter->flush_pending(std::chrono::steady_clock::now() + 1h);
+
+    // observer never goes back to a stale value & old_temp is the previously delivered value
+    bool in_order = true;
+    for (std::size_t i = 1; i < display->events.size(); ++i)
+        in_order = in_order && display->events[i].new_temp > display->events[i - 1].new_temp
+            && display->events[i].old_temp == display->events[i - 1].new_temp;
+
+    REQUIRE(in_order);
+    REQUIRE(display->events.back().new_temp == updates_count);
+    REQUIRE(filter->stats().delivered == display->events.size());
+}
+
+TEST_CASE("TempMonitor::flush_pending() reaches forwarders")
+{
+    TempMonitor monitor;
+    auto observer = std::make_shared<RecordingObserver>();
+    auto forwarder = std::make_shared<FlushCountingForwarder>();
+    monitor.register_observer(observer, forwarder);
+
+    monitor.flush_pending();
+    REQUIRE(forwarder->flushes == 1);
+
+    observer.reset();
+    monitor.flush_pending();
+    REQUIRE(forwarder->flushes == 1); // forwarders of expired observers are skipped
+}
+
+TEST_CASE("coalescing observer - jittering sensor", "[.][benchmark]")
+{
+    using namespace std::chrono_literals;
+
+    TempMonitor monitor;
+
+    auto display = std::make_shared<CountingDisplay>();
+    auto filter = register_coalescing_observer(monitor, display, CoalescingOptions {100ms, 1});
+
+    std::atomic<bool> done {false};
+    std::thread ticker {[&] {
+        while (!done)
+        {
+            std::this_thread::sleep_for(10ms);
+            monitor.flush_pending();
+        }
+    }};
+
+    // jittering sensor: 20, 21, 20, 21, ... with a slow drift upwards
+    int i = 0;
+    BENCHMARK("set_temp: coalescing observer - 100ms, hysteresis 1")
+    {
+        ++i;
+        monitor.set_temp(20 + i / 500'000 * 2 + i % 2);
+        return i;
+    };
+
+    std::this_thread::sleep_for(150ms); // last value is delivered by the ticker
+    done = true;
+    ticker.join();
+
+    auto stats = filter->stats();
+    std::cout << "sensor updates: " << stats.received << ", notifications: " << stats.delivered
+              << ", last delivered temp: " << display->last_temp << " (sensor: " << monitor.temp() << ")\n";
+
+    CHECK(stats.delivered == static_cast<std::uint64_t>(display->count));
+    CHECK(std::abs(display->last_temp - monitor.temp()) <= 1); // within hysteresis
+}
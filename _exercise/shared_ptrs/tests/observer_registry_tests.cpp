@@ -0,0 +1,291 @@
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch.hpp"
+#include "temp_monitor.hpp"
+
+namespace
+{
+    class CountingObserver : public Observer
+    {
+    public:
+        std::atomic<long> count {0};
+
+        void update(TempChanged) override
+        {
+            ++count;
+        }
+    };
+
+    class SelfUnregisteringObserver : public Observer, public std::enable_shared_from_this<SelfUnregisteringObserver>
+    {
+        TempMonitor& monitor_;
+
+    public:
+        std::atomic<int> count {0};
+
+        explicit SelfUnregisteringObserver(TempMonitor& monitor)
+            : monitor_ {monitor}
+        {
+        }
+
+        void update(TempChanged) override
+        {
+            ++count;
+            monitor_.unregister_observer(weak_from_this());
+        }
+    };
+
+    class RegisteringObserver : public Observer
+    {
+        TempMonitor& monitor_;
+        std::shared_ptr<Observer> other_;
+
+    public:
+        RegisteringObserver(TempMonitor& monitor, std::shared_ptr<Observer> other)
+            : monitor_ {monitor}
+            , other_ {std::move(other)}
+        {
+        }
+
+        void update(TempChanged) override
+        {
+            monitor_.register_observer(other_);
+        }
+    };
+
+    // notification through std::set of weak_ptrs - previous implementation of TempMonitor
+    class SetBasedTempMonitor
+    {
+        int temp_ = 0;
+        std::set<std::weak_ptr<Observer>, std::owner_less<std::weak_ptr<Observer>>> observers_;
+
+    public:
+        void register_observer(std::weak_ptr<Observer> observer)
+        {
+            observers_.insert(observer);
+        }
+
+        void set_temp(int new_temp)
+        {
+            if (temp_ != new_temp)
+            {
+                TempChanged event {temp_, new_temp, std::chrono::steady_clock::now()};
+                temp_ = new_temp;
+
+                for (std::weak_ptr<Observer> observer : observers_)
+                {
+                    if (std::shared_ptr<Observer> living_observer = observer.lock(); living_observer)
+                        living_observer->update(event);
+                }
+            }
+        }
+    };
+
+    template <typename TMonitor>
+    void benchmark_notify(const std::string& name, std::size_t observers_count)
+    {
+        std::vector<std::shared_ptr<CountingObserver>> observers;
+        TMonitor monitor;
+
+        for (std::size_t i = 0; i < observers_count; ++i)
+        {
+            observers.push_back(std::make_shared<CountingObserver>());
+            monitor.register_observer(observers.back());
+        }
+
+        int temp = 0;
+        BENCHMARK(name + " - " + std::to_string(observers_count) + " observers")
+        {
+            monitor.set_temp(++temp);
+            return observers.front()->count.load();
+        };
+    }
+}
+
+TEST_CASE("ObserverRegistry")
+{
+    ObserverRegistry registry;
+
+    auto first = std::make_shared<CountingObserver>();
+    auto second = std::make_shared<CountingObserver>();
+
+    REQUIRE(registry.add(first));
+    REQUIRE(registry.add(second));
+
+    SECTION("observer is registered once")
+    {
+        REQUIRE_FALSE(registry.add(first));
+        REQUIRE(registry.size() == 2);
+    }
+
+    SECTION("removed observer is not notified")
+    {
+        REQUIRE(registry.remove(first));
+        REQUIRE_FALSE(registry.remove(first));
+
+        registry.for_each_alive([](Observer& observer) { observer.update(TempChanged {}); });
+
+        REQUIRE(first->count == 0);
+        REQUIRE(second->count == 1);
+    }
+
+    SECTION("expired observers are skipped & removed in a batch")
+    {
+        std::vector<std::shared_ptr<CountingObserver>> temporary;
+        for (int i = 0; i < 16; ++i)
+        {
+            temporary.push_back(std::make_shared<CountingObserver>());
+            registry.add(temporary.back());
+        }
+        REQUIRE(registry.size() == 18);
+
+        temporary.clear();
+
+        int notified = 0;
+        registry.for_each_alive([&notified](Observer&) { ++notified; });
+
+        REQUIRE(notified == 2);
+        REQUIRE(registry.size() == 2);
+    }
+}
+
+TEST_CASE("TempMonitor notifies registered observers about changes")
+{
+    TempMonitor monitor;
+    auto observer = std::make_shared<CountingObserver>();
+    monitor.register_observer(observer);
+
+    monitor.set_temp(1);
+    monitor.set_temp(1);
+    monitor.set_temp(2);
+    REQUIRE(observer->count == 2);
+
+    monitor.unregister_observer(observer);
+    monitor.set_temp(3);
+    REQUIRE(observer->count == 2);
+}
+
+TEST_CASE("TempMonitor - observers modifying registrations inside update()")
+{
+    TempMonitor monitor;
+
+    SECTION("observer may unregister itself")
+    {
+        auto one_shot = std::make_shared<SelfUnregisteringObserver>(monitor);
+        monitor.register_observer(one_shot);
+
+        monitor.set_temp(1);
+        monitor.set_temp(2);
+
+        REQUIRE(one_shot->count == 1);
+    }
+
+    SECTION("observer registered during notification gets next notifications")
+    {
+        auto late = std::make_shared<CountingObserver>();
+        auto registering = std::make_shared<RegisteringObserver>(monitor, late);
+        monitor.register_observer(registering);
+
+        monitor.set_temp(1);
+        REQUIRE(late->count == 0);
+
+        monitor.set_temp(2);
+        REQUIRE(late->count == 1);
+    }
+}
+
+TEST_CASE("TempMonitor - concurrent set_temp() & registration")
+{
+    constexpr int sensors_count = 4;
+    constexpr int updates_per_sensor = 10'000;
+
+    TempMonitor monitor;
+    auto observer = std::make_shared<CountingObserver>();
+    monitor.register_observer(observer);
+
+    std::atomic<bool> done {false};
+    std::thread registering_thread {[&] {
+        while (!done)
+        {
+            auto temporary = std::make_shared<CountingObserver>();
+            monitor.register_observer(temporary);
+            monitor.unregister_observer(temporary);
+        }
+    }};
+
+    std::vector<std::thread> sensors;
+    for (int s = 0; s < sensors_count; ++s)
+        sensors.emplace_back([&monitor, s] {
+            for (int i = 1; i <= updates_per_sensor; ++i)
+                monitor.set_temp(s * updates_per_sensor + i); // values are unique - every call is a change
+        });
+
+    for (auto& sensor : sensors)
+        sensor.join();
+
+    done = true;
+    registering_thread.join();
+
+    REQUIRE(observer->count == sensors_count * updates_per_sensor);
+}
+
+TEST_CASE("notify observers", "[.][benchmark]")
+{
+    std::thread {[] {}}.join(); // libstdc++ skips atomic operations in shared_ptr until the first thread is started
+
+    for (std::size_t observers_count : {1, 100, 10'000})
+    {
+        benchmark_notify<SetBasedTempMonitor>("std::set<weak_ptr>", observers_count);
+        benchmark_notify<TempMonitor>("ObserverRegistry", observers_count);
+    }
+}
+
+TEST_CASE("TempMonitor - set_temp() from many threads", "[.][benchmark]")
+{
+    constexpr int sensors_count = 4;
+    constexpr int updates_per_sensor = 10'000;
+
+    TempMonitor monitor;
+
+    std::vector<std::shared_ptr<CountingObserver>> observers;
+    for (int i = 0; i < 100; ++i)
+    {
+        observers.push_back(std::make_shared<CountingObserver>());
+        monitor.register_observer(observers.back());
+    }
+
+    // one-shot observers are registered & unregister themselves during notifications
+    std::atomic<bool> sensors_done {false};
+    std::thread management_thread {[&] {
+        while (!sensors_done)
+        {
+            auto one_shot = std::make_shared<SelfUnregisteringObserver>(monitor);
+            monitor.register_observer(one_shot);
+            std::this_thread::yield();
+        }
+    }};
+
+    BENCHMARK("set_temp() from " + std::to_string(sensors_count) + " threads - 100 observers")
+    {
+        std::vector<std::thread> sensors;
+        for (int s = 0; s < sensors_count; ++s)
+            sensors.emplace_back([&monitor, s] {
+                for (int i = 0; i < updates_per_sensor; ++i)
+                    monitor.set_temp(s * updates_per_sensor + i);
+            });
+
+        for (auto& sensor : sensors)
+            sensor.join();
+
+        return observers.front()->count.load();
+    };
+
+    sensors_done = true;
+    management_thread.join();
+}
@@ -0,0 +1,248 @@
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "catch.hpp"
+#include "sensor_bank.hpp"
+
+namespace
+{
+    class RecordingObserver : public Observer
+    {
+    public:
+        std::vector<TempChanged> events;
+
+        void update(TempChanged event) override
+        {
+            events.push_back(event);
+        }
+    };
+
+    class CountingObserver : public Observer
+    {
+    public:
+        long count = 0;
+
+        void update(TempChanged) override
+        {
+            ++count;
+        }
+    };
+
+    constexpr std::size_t bench_sensors_count = 100'000;
+    constexpr std::size_t bench_ticks = 64;
+    constexpr int bench_threshold = 1; // jitter of +/- 1 is ignored
+
+    // readings for consecutive ticks: jitter on all sensors, real changes on ~1% of them
+    std::vector<std::vector<int>> generate_readings()
+    {
+        std::mt19937 rnd {42};
+        std::uniform_int_distribution<int> jitter {-bench_threshold, bench_threshold};
+        std::uniform_int_distribution<int> change_chance {0, 99};
+
+        std::vector<int> temps(bench_sensors_count, 20);
+        std::vector<std::vector<int>> readings(bench_ticks);
+
+        for (auto& tick : readings)
+        {
+            tick.resize(bench_sensors_count);
+            for (std::size_t i = 0; i < bench_sensors_count; ++i)
+            {
+                if (change_chance(rnd) == 0)
+                    temps[i] += 5;
+                tick[i] = temps[i] + jitter(rnd);
+            }
+        }
+
+        return readings;
+    }
+}
+
+TEST_CASE("SensorScan - vectorized scan finds the same sensors as scalar scan")
+{
+    using namespace Catch::Matchers;
+
+    std::mt19937 rnd {665};
+    std::uniform_int_distribution<int> temp {-50, 50};
+    std::uniform_int_distribution<int> threshold {0, 5};
+
+    for (std::size_t count : {0, 1, 3, 4, 5, 7, 8, 37, 10'007})
+    {
+        std::vector<std::int32_t> temps(count), readings(count), thresholds(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            temps[i] = temp(rnd);
+            readings[i] = temps[i] + temp(rnd) / 10;
+            thresholds[i] = threshold(rnd);
+        }
+
+        std::vector<std::uint32_t> expected;
+        SensorScan::scan_changes_scalar(temps.data(), readings.data(), thresholds.data(), 0, count, expected);
+
+        std::vector<std::uint32_t> changed;
+        SensorScan::scan_changes(temps.data(), readings.data(), thresholds.data(), count, changed);
+
+        INFO("count: " << count);
+        REQUIRE_THAT(changed, Equals(expected));
+    }
+}
+
+TEST_CASE("SensorScan - extreme values don't overflow")
+{
+    using namespace Catch::Matchers;
+
+    constexpr std::int32_t min = std::numeric_limits<std::int32_t>::min();
+    constexpr std::int32_t max = std::numeric_limits<std::int32_t>::max();
+
+    const std::vector<std::int32_t> temps = {min, max, min, max, min, 0, max, -1};
+    const std::vector<std::int32_t> readings = {max, min, min + 1, max - 1, max, min, max, max};
+    const std::vector<std::int32_t> thresholds = {max, max, 0, 1, 0, max, 0, max};
+
+    const std::vector<std::uint32_t> expected = {0, 1, 2, 4, 5, 7};
+
+    std::vector<std::uint32_t> scalar;
+    SensorScan::scan_changes_scalar(temps.data(), readings.data(), thresholds.data(), 0, temps.size(), scalar);
+    REQUIRE_THAT(scalar, Equals(expected));
+
+    std::vector<std::uint32_t> changed;
+    SensorScan::scan_changes(temps.data(), readings.data(), thresholds.data(), temps.size(), changed);
+    REQUIRE_THAT(changed, Equals(expected));
+
+    SECTION("random values from the whole range")
+    {
+        std::mt19937 rnd {665};
+        std::uniform_int_distribution<std::int32_t> any_value {min, max};
+        std::uniform_int_distribution<std::int32_t> any_threshold {0, max};
+
+        std::vector<std::int32_t> random_temps(10'000), random_readings(10'000), random_thresholds(10'000);
+        for (std::size_t i = 0; i < random_temps.size(); ++i)
+        {
+            random_temps[i] = any_value(rnd);
+            random_readings[i] = any_value(rnd);
+            random_thresholds[i] = any_threshold(rnd);
+        }
+
+        std::vector<std::uint32_t> expected_random;
+        SensorScan::scan_changes_scalar(random_temps.data(), random_readings.data(), random_thresholds.data(), 0, random_temps.size(), expected_random);
+
+        std::vector<std::uint32_t> changed_random;
+        SensorScan::scan_changes(random_temps.data(), random_readings.data(), random_thresholds.data(), random_temps.size(), changed_random);
+
+        REQUIRE_THAT(changed_random, Equals(expected_random));
+    }
+}
+
+TEST_CASE("TempSensorBank")
+{
+    using namespace Catch::Matchers;
+
+    TempSensorBank bank {10, 20, 1};
+    bank.set_threshold(7, 5);
+
+    auto observer = std::make_shared<RecordingObserver>();
+    bank.register_observer(3, observer);
+
+    std::vector<int> readings(10, 20);
+    readings[1] = 21; // within threshold
+    readings[3] = 25;
+    readings[7] = 24; // within threshold of sensor 7
+    readings[9] = 15;
+
+    const auto& changed = bank.update(readings);
+
+    REQUIRE_THAT(changed, Equals(std::vector<std::uint32_t> {3, 9}));
+    REQUIRE(bank.temp(1) == 20);
+    REQUIRE(bank.temp(3) == 25);
+    REQUIRE(bank.temp(9) == 15);
+
+    REQUIRE(observer->events.size() == 1);
+    REQUIRE(observer->events[0].old_temp == 20);
+    REQUIRE(observer->events[0].new_temp == 25);
+
+    SECTION("number of readings must match number of sensors")
+    {
+        REQUIRE_THROWS_AS(bank.update(std::vector<int>(9)), std::invalid_argument);
+    }
+
+    SECTION("threshold must not be negative")
+    {
+        REQUIRE_THROWS_AS(bank.set_threshold(1, -1), std::invalid_argument);
+        REQUIRE_THROWS_AS(TempSensorBank(1, 0, -1), std::invalid_argument);
+    }
+
+    SECTION("invalid sensor")
+    {
+        REQUIRE_THROWS_AS(bank.register_observer(10, observer), std::out_of_range);
+    }
+}
+
+TEST_CASE("100k sensors per tick", "[.][benchmark]")
+{
+    const auto readings = generate_readings();
+
+    // 1% of sensors are observed
+    std::vector<std::shared_ptr<CountingObserver>> observers;
+    for (std::size_t i = 0; i < bench_sensors_count / 100; ++i)
+        observers.push_back(std::make_shared<CountingObserver>());
+
+    {
+        std::vector<std::unique_ptr<TempMonitor>> monitors;
+        for (std::size_t i = 0; i < bench_sensors_count; ++i)
+        {
+            monitors.push_back(std::make_unique<TempMonitor>());
+            monitors.back()->set_temp(20);
+        }
+        for (std::size_t i = 0; i < observers.size(); ++i)
+            monitors[i * 100]->register_observer(observers[i]);
+
+        std::size_t tick = 0;
+        BENCHMARK("TempMonitor per sensor (no threshold)")
+        {
+            const auto& tick_readings = readings[tick++ % bench_ticks];
+            for (std::size_t i = 0; i < bench_sensors_count; ++i)
+                monitors[i]->set_temp(tick_readings[i]);
+            return tick;
+        };
+    }
+
+    {
+        // readings of the previous tick are current temps
+        std::vector<std::int32_t> thresholds(bench_sensors_count, bench_threshold);
+        std::vector<std::uint32_t> changed;
+        changed.reserve(bench_sensors_count);
+
+        std::size_t tick = 0;
+        BENCHMARK("scan only - scalar")
+        {
+            changed.clear();
+            const auto& temps = readings[tick % bench_ticks];
+            SensorScan::scan_changes_scalar(temps.data(), readings[++tick % bench_ticks].data(), thresholds.data(), 0, bench_sensors_count, changed);
+            return changed.size();
+        };
+
+        tick = 0;
+        BENCHMARK("scan only - SIMD")
+        {
+            changed.clear();
+            const auto& temps = readings[tick % bench_ticks];
+            SensorScan::scan_changes(temps.data(), readings[++tick % bench_ticks].data(), thresholds.data(), bench_sensors_count, changed);
+            return changed.size();
+        };
+    }
+
+    {
+        TempSensorBank bank {bench_sensors_count, 20, bench_threshold};
+        for (std::size_t i = 0; i < observers.size(); ++i)
+            bank.register_observer(i * 100, observers[i]);
+
+        std::size_t tick = 0;
+        BENCHMARK("TempSensorBank")
+        {
+            bank.update(readings[tick++ % bench_ticks]);
+            return tick;
+        };
+    }
+}
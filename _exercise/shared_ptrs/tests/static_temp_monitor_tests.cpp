@@ -0,0 +1,99 @@
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch.hpp"
+#include "static_temp_monitor.hpp"
+
+namespace
+{
+    class TypedObserver final : public Observer
+    {
+    public:
+        std::vector<int> temps;
+
+        void update(TempChanged event) override
+        {
+            temps.push_back(event.new_temp);
+        }
+    };
+
+    class TextRecorder final : public TextObserver
+    {
+    public:
+        using TextObserver::update;
+
+        std::vector<std::string> texts;
+
+        void update(const std::string& event) override
+        {
+            texts.push_back(event);
+        }
+    };
+
+    template <int Id>
+    class CountingObserver final : public Observer
+    {
+    public:
+        long sum = 0;
+
+        void update(TempChanged event) override
+        {
+            sum += event.new_temp - event.old_temp;
+        }
+    };
+}
+
+TEST_CASE("StaticTempMonitor")
+{
+    using namespace Catch::Matchers;
+
+    TypedObserver typed;
+    TextRecorder text;
+    StaticTempMonitor monitor {typed, text};
+
+    monitor.set_temp(1);
+    monitor.set_temp(1);
+    monitor.set_temp(2);
+
+    REQUIRE(monitor.temp() == 2);
+    REQUIRE_THAT(typed.temps, Equals(std::vector<int> {1, 2}));
+    REQUIRE_THAT(text.texts, Equals(std::vector<std::string> {"Temp changed on: 1", "Temp changed on: 2"}));
+}
+
+TEST_CASE("notify 4 observers", "[.][benchmark]")
+{
+    std::thread {[] {}}.join(); // libstdc++ skips atomic operations in shared_ptr until the first thread is started
+
+    CountingObserver<1> o1;
+    CountingObserver<2> o2;
+    CountingObserver<3> o3;
+    CountingObserver<4> o4;
+    StaticTempMonitor static_monitor {o1, o2, o3, o4};
+
+    int static_temp = 0;
+    BENCHMARK("StaticTempMonitor")
+    {
+        static_monitor.set_temp(++static_temp);
+        return o1.sum + o2.sum + o3.sum + o4.sum;
+    };
+
+    auto so1 = std::make_shared<CountingObserver<1>>();
+    auto so2 = std::make_shared<CountingObserver<2>>();
+    auto so3 = std::make_shared<CountingObserver<3>>();
+    auto so4 = std::make_shared<CountingObserver<4>>();
+
+    TempMonitor monitor;
+    monitor.register_observer(so1);
+    monitor.register_observer(so2);
+    monitor.register_observer(so3);
+    monitor.register_observer(so4);
+
+    int temp = 0;
+    BENCHMARK("TempMonitor")
+    {
+        monitor.set_temp(++temp);
+        return so1->sum + so2->sum + so3->sum + so4->sum;
+    };
+}
@@ -0,0 +1,191 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "catch.hpp"
+#include "temp_history.hpp"
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    std::vector<int> temps_in(const TempHistory& history, HistoryClock::time_point from, HistoryClock::time_point to)
+    {
+        std::vector<int> temps;
+        history.visit(from, to, [&temps](const TempSample& sample) { temps.push_back(sample.temp); });
+        return temps;
+    }
+}
+
+TEST_CASE("TempHistory")
+{
+    using namespace Catch::Matchers;
+
+    const HistoryClock::time_point start {std::chrono::hours(24 * 365 * 50)}; // full minute
+    TempHistory history {HistoryOptions {8, 16, 16}};
+
+    SECTION("window of raw samples")
+    {
+        for (int i = 0; i < 5; ++i)
+            history.record(20 + i, start + i * 100ms);
+
+        REQUIRE_THAT(temps_in(history, start + 100ms, start + 300ms), Equals(std::vector<int> {21, 22, 23}));
+        REQUIRE(temps_in(history, start + 1s, start + 2s).empty());
+    }
+
+    SECTION("only the last capacity samples are stored")
+    {
+        for (int i = 0; i < 20; ++i)
+            history.record(i, start + i * 1ms);
+
+        REQUIRE(history.samples_count() == 20);
+        REQUIRE_THAT(temps_in(history, start, start + 1h), Equals(std::vector<int> {12, 13, 14, 15, 16, 17, 18, 19}));
+    }
+
+    SECTION("1 s aggregates of completed periods")
+    {
+        history.record(10, start);
+        history.record(30, start + 500ms);
+        history.record(5, start + 1s);
+        history.record(7, start + 2s + 1ms);
+
+        std::vector<TempAggregate> aggregates;
+        history.visit(HistoryTier::seconds, start, start + 1h, [&](const TempAggregate& a) { aggregates.push_back(a); });
+
+        REQUIRE(aggregates.size() == 2);
+        REQUIRE(aggregates[0].min == 10);
+        REQUIRE(aggregates[0].max == 30);
+        REQUIRE(aggregates[0].count == 2);
+        REQUIRE(aggregates[0].average() == Catch::Detail::Approx(20.0));
+        REQUIRE(aggregates[1].count == 1);
+        REQUIRE(aggregates[1].sum == 5);
+    }
+}
+
+TEST_CASE("TempHistory - persistence in memory mapped file")
+{
+    using namespace Catch::Matchers;
+
+    const std::string path = "/tmp/temp_history_tests_" + std::to_string(::getpid()) + ".bin";
+    const HistoryOptions options {64, 16, 16};
+    const HistoryClock::time_point start {std::chrono::hours(24 * 365 * 50)};
+
+    {
+        TempHistory history {path, options};
+        for (int i = 0; i < 100; ++i)
+            history.record(i, start + i * 10ms);
+    }
+
+    {
+        TempHistory restored {path, options};
+
+        REQUIRE(restored.samples_count() == 100);
+
+        std::vector<int> expected;
+        for (int i = 36; i < 100; ++i)
+            expected.push_back(i);
+        REQUIRE_THAT(temps_in(restored, start, start + 1h), Equals(expected));
+
+        restored.record(100, start + 1s);
+        REQUIRE(temps_in(restored, start + 1s, start + 1s) == std::vector<int> {100});
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("TempHistory - queries running concurrently with the writer")
+{
+    const HistoryClock::time_point start {std::chrono::hours(24 * 365 * 50)};
+    TempHistory history {HistoryOptions {64, 16, 16}};
+
+    for (int i = 0; i < 64; ++i)
+        history.record(i, start + i * 1ms);
+
+    std::atomic<bool> done {false};
+    std::thread writer {[&] {
+        for (int i = 64; !done; ++i)
+            history.record(i, start + i * 1ms);
+    }};
+
+    bool always_found = true;
+    bool in_order = true;
+    for (int query = 0; query < 20'000; ++query)
+    {
+        std::vector<int> temps = temps_in(history, start, start + 24h);
+
+        always_found = always_found && !temps.empty(); // ring is full - window is never empty
+        in_order = in_order && std::is_sorted(temps.begin(), temps.end());
+    }
+
+    done = true;
+    writer.join();
+
+    REQUIRE(always_found);
+    REQUIRE(in_order);
+}
+
+TEST_CASE("TempHistory - record & visit", "[.][benchmark]")
+{
+    const auto start = HistoryClock::now();
+
+    // samples every 10 ms of simulated time
+    TempHistory history {HistoryOptions {65536, 3600, 1440}};
+    int i = 0;
+    BENCHMARK("TempHistory::record()")
+    {
+        ++i;
+        history.record(20 + i % 7, start + i * 10ms);
+        return i;
+    };
+
+    auto now = start + i * 10ms;
+    BENCHMARK("TempHistory::visit() - last 60 s of raw samples")
+    {
+        long visited = 0;
+        history.visit(now - 60s, now, [&](const TempSample& sample) { visited += sample.temp; });
+        return visited;
+    };
+    BENCHMARK("TempHistory::visit() - last hour of 1 s aggregates")
+    {
+        long visited = 0;
+        history.visit(HistoryTier::seconds, now - 1h, now, [&](const TempAggregate& aggregate) { visited += aggregate.count; });
+        return visited;
+    };
+
+    // readers validate samples while the writer overwrites the ring
+    TempHistory concurrent_history {HistoryOptions {1024, 60, 60}};
+    std::atomic<bool> done {false};
+    std::atomic<long> torn_reads {0};
+
+    std::thread reader {[&] {
+        while (!done)
+        {
+            std::int64_t previous = 0;
+            concurrent_history.visit(HistoryClock::time_point {}, HistoryClock::time_point::max(), [&](const TempSample& sample) {
+                if (sample.timestamp_ns <= previous || sample.temp != sample.timestamp_ns % 1000)
+                    ++torn_reads;
+                previous = sample.timestamp_ns;
+            });
+        }
+    }};
+
+    int t = 0;
+    BENCHMARK("TempHistory::record() - with concurrent reader")
+    {
+        ++t;
+        concurrent_history.record(t % 1000, HistoryClock::time_point {std::chrono::nanoseconds(t)});
+        return t;
+    };
+
+    done = true;
+    reader.join();
+
+    CHECK(torn_reads == 0);
+}
@@ -0,0 +1,101 @@
+#define INSTRUMENTATION_HOOK_GLOBAL_NEW
+
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+#include "instrumentation.hpp"
+
+using namespace Instrumentation;
+
+TEST_CASE("zero-copy hot paths - push_back")
+{
+    std::vector<InstrumentedGadget> gadgets;
+    gadgets.reserve(100);
+
+    InstrumentedGadget g {1, "a name that does not fit into small string buffer"};
+
+    SECTION("push_back(std::move(g)) performs 0 copies and 0 allocations")
+    {
+        OperationsCounter operations;
+        AllocationCounter allocations;
+
+        gadgets.push_back(std::move(g));
+
+        auto allocs = allocations.allocations();
+        REQUIRE(operations.copies() == 0);
+        REQUIRE(operations.moves() == 1);
+        REQUIRE(allocs == 0);
+    }
+
+    SECTION("push_back(g) copies a gadget & its name")
+    {
+        OperationsCounter operations;
+        AllocationCounter allocations;
+
+        gadgets.push_back(g);
+
+        auto allocs = allocations.allocations();
+        REQUIRE(operations.copies() == 1);
+        REQUIRE(allocs == 1);
+    }
+
+    SECTION("emplace_back constructs gadget in place")
+    {
+        OperationsCounter operations;
+        AllocationCounter allocations;
+
+        gadgets.emplace_back(2, "ipad");
+
+        auto allocs = allocations.allocations();
+        REQUIRE(operations.copies() == 0);
+        REQUIRE(operations.moves() == 0);
+        REQUIRE(allocs == 0);
+    }
+}
+
+TEST_CASE("zero-copy hot paths - returning by value")
+{
+    auto make_gadget = [] { return InstrumentedGadget {42, "ipad"}; };
+
+    OperationsCounter operations;
+    AllocationCounter allocations;
+
+    InstrumentedGadget g = make_gadget(); // copy elision
+
+    auto allocs = allocations.allocations();
+    REQUIRE(operations.copies() == 0);
+    REQUIRE(operations.moves() == 0);
+    REQUIRE(allocs == 0);
+}
+
+TEST_CASE("interned names do not allocate")
+{
+    using InstrumentedInternedGadget = Utils::BasicGadget<Utils::CountingTracing, Utils::InternedName>;
+
+    InstrumentedInternedGadget prototype {1, "a name that does not fit into small string buffer"};
+
+    AllocationCounter allocations;
+
+    InstrumentedInternedGadget g1 {2, "a name that does not fit into small string buffer"};
+    InstrumentedInternedGadget g2 = g1;
+
+    auto allocs = allocations.allocations();
+    REQUIRE(allocs == 0);
+}
+
+TEST_CASE("buffered print of numbers does not allocate")
+{
+    std::vector<int> data(100'000, 42);
+    size_t size = 0;
+    auto sink = [&size](const char*, size_t n) { size += n; };
+
+    Utils::print(data, "warm-up", sink);
+
+    AllocationCounter allocations;
+
+    Utils::print(data, "data", sink);
+
+    auto allocs = allocations.allocations();
+    REQUIRE(allocs == 0);
+}
@@ -33,6 +33,81 @@ TEST_CASE("move semantics")
     std::string s2 = s1;
 }
 
+TEST_CASE("move semantics - counting copies & moves")
+{
+    using CountedGadget = BasicGadget<CountingTracing>;
+
+    CountingTracing::reset();
+
+    {
+        std::vector<CountedGadget> gadgets;
+        gadgets.reserve(100);
+
+        CountedGadget g {0, "ipad0"};
+        gadgets.push_back(g);
+        gadgets.push_back(CountedGadget {1, "ipad1"});
+        gadgets.push_back(std::move(g));
+    }
+
+    auto counters = CountingTracing::counters();
+    REQUIRE(counters.constructions == 2);
+    REQUIRE(counters.copies == 1);
+    REQUIRE(counters.moves == 2);
+    REQUIRE(counters.destructions == 5);
+}
+
+TEST_CASE("interned gadget names")
+{
+    static_assert(sizeof(InternedName) == sizeof(void*));
+
+    InternedGadget g1 {1, "reverb"};
+    InternedGadget g2 {2, "reverb"};
+    InternedGadget g3 {3, "overdrive"};
+
+    std::string_view name = g1.name();
+    REQUIRE(name == "reverb"sv);
+    REQUIRE(g1.name().data() == g2.name().data()); // the same interned text
+    REQUIRE(g3.name() == "overdrive"sv);
+
+    InternedGadget g4 = std::move(g1);
+    REQUIRE(g4.name() == "reverb"sv);
+    REQUIRE(g1.name().empty());
+}
+
+TEST_CASE("buffered print")
+{
+    std::string output;
+    size_t writes = 0;
+    auto to_output = [&](const char* data, size_t size) { output.append(data, size); ++writes; };
+
+    SECTION("numbers")
+    {
+        Utils::print(std::vector {1, -2, 3}, "ints", to_output);
+        Utils::print(std::vector {0.5, 3.14159265}, "doubles", to_output);
+
+        REQUIRE(output == "ints: [ 1 -2 3 ]\ndoubles: [ 0.5 3.14159 ]\n"s);
+    }
+
+    SECTION("items with operator<<")
+    {
+        using SilentGadget = BasicGadget<SilentTracing>;
+
+        Utils::print(std::vector<SilentGadget> {{1, "ipad"}, {2, "ipod"}}, "gadgets", to_output);
+
+        REQUIRE(output == "gadgets: [ Gadget{id: 1, name: ipad} Gadget{id: 2, name: ipod} ]\n"s);
+    }
+
+    SECTION("large container is written in buffer-fulls")
+    {
+        std::vector<int> data(1'000'000, 7);
+
+        Utils::print(data, "data", to_output);
+
+        REQUIRE(output.size() == "data: [ "s.size() + 2 * data.size() + "]\n"s.size());
+        REQUIRE(writes == (output.size() + 16 * 1024 - 1) / (16 * 1024));
+    }
+}
+
 std::string full_name(const std::string& first, const std::string& last)
 {
     return first + " " + last;
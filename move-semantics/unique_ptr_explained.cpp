@@ -1,3 +1,7 @@
+#include <algorithm>
+#include <cstdio>
+#include <type_traits>
+
 #include "catch.hpp"
 #include "utils.hpp"
 
@@ -7,20 +11,115 @@ using namespace std::literals;
 namespace explain
 {
     template <typename T>
+    struct default_delete
+    {
+        void operator()(T* ptr) const
+        {
+            delete ptr;
+        }
+    };
+
+    template <typename T>
+    struct default_delete<T[]>
+    {
+        void operator()(T* ptr) const
+        {
+            delete[] ptr;
+        }
+    };
+
+    namespace detail
+    {
+        // stateless deleter (empty class) is a base class - empty base optimization: sizeof(pair) == sizeof(T*)
+        template <typename T, typename Deleter, bool = std::is_empty_v<Deleter> && !std::is_final_v<Deleter>>
+        class compressed_pair : private Deleter
+        {
+            T* ptr_;
+
+        public:
+            compressed_pair(T* ptr, Deleter deleter)
+                : Deleter {std::move(deleter)}
+                , ptr_ {ptr}
+            {
+            }
+
+            T*& pointer()
+            {
+                return ptr_;
+            }
+
+            T* pointer() const
+            {
+                return ptr_;
+            }
+
+            Deleter& deleter()
+            {
+                return *this;
+            }
+
+            const Deleter& deleter() const
+            {
+                return *this;
+            }
+        };
+
+        // deleter with state (or pointer to function) is stored as a member
+        template <typename T, typename Deleter>
+        class compressed_pair<T, Deleter, false>
+        {
+            T* ptr_;
+            Deleter deleter_;
+
+        public:
+            compressed_pair(T* ptr, Deleter deleter)
+                : ptr_ {ptr}
+                , deleter_ {std::move(deleter)}
+            {
+            }
+
+            T*& pointer()
+            {
+                return ptr_;
+            }
+
+            T* pointer() const
+            {
+                return ptr_;
+            }
+
+            Deleter& deleter()
+            {
+                return deleter_;
+            }
+
+            const Deleter& deleter() const
+            {
+                return deleter_;
+            }
+        };
+    }
+
+    template <typename T, typename Deleter = default_delete<T>>
     class unique_ptr
     {
-        T* ptr_ = nullptr;
+        detail::compressed_pair<T, Deleter> ptr_ {nullptr, Deleter {}};
 
     public:
         unique_ptr() = default;
 
         explicit unique_ptr(T* ptr)
-            : ptr_ {ptr}
+            : ptr_ {ptr, Deleter {}}
+        {
+        }
+
+        unique_ptr(T* ptr, Deleter deleter)
+            : ptr_ {ptr, std::move(deleter)}
         {
         }
 
         unique_ptr(nullptr_t)
-            : ptr_ {nullptr}
+            : ptr_ {nullptr, Deleter {}}
         {
         }
 
@@ -29,19 +128,16 @@ namespace explain
 
         // move constructor
         unique_ptr(unique_ptr&& other)
-            : ptr_ {other.ptr_}
+            : ptr_ {other.release(), std::move(other.get_deleter())}
         {
-            other.ptr_ = nullptr;
         }
 
         unique_ptr& operator=(unique_ptr&& other) // move assignment
         {
             if (this != &other) // avoiding self-assignment
             {
-                delete ptr_;
-
-                ptr_ = other.ptr_;
-                other.ptr_ = nullptr;
+                reset(other.release());
+                get_deleter() = std::move(other.get_deleter());
             }
 
             return *this;
@@ -49,23 +145,45 @@ namespace explain
 
         ~unique_ptr()
         {
-            if (ptr_)
-                delete ptr_;
+            if (get())
+                get_deleter()(get());
+        }
+
+        T* get() const
+        {
+            return ptr_.pointer();
+        }
+
+        Deleter& get_deleter()
+        {
+            return ptr_.deleter();
+        }
+
+        T* release()
+        {
+            return std::exchange(ptr_.pointer(), nullptr);
+        }
+
+        void reset(T* ptr = nullptr)
+        {
+            T* old_ptr = std::exchange(ptr_.pointer(), ptr);
+            if (old_ptr)
+                get_deleter()(old_ptr);
         }
 
         T& operator*() const
         {
-            return *ptr_;
+            return *get();
         }
 
         T* operator->() const
         {
-            return ptr_;
+            return get();
         }
 
         explicit operator bool() const
         {
-            return ptr_ != nullptr;
+            return get() != nullptr;
         }
     };
 
@@ -89,27 +207,53 @@ namespace explain
 
     // implementation with variadic templates
     template <typename T, typename... TArgs>
-    explain::unique_ptr<T> make_unique(TArgs&&... args)
+    std::enable_if_t<!std::is_array_v<T>, explain::unique_ptr<T>> make_unique(TArgs&&... args)
     {
         return explain::unique_ptr<T>(new 
         T(std::forward<TArgs>(args)...));
     }
 
+    // array with value-initialized items - new T[size]() - ints are zeroed
     template <typename T>
-    class unique_ptr<T[]>
+    std::enable_if_t<std::is_array_v<T> && std::extent_v<T> == 0, explain::unique_ptr<T>> make_unique(size_t size)
     {
-        T* ptr_ = nullptr;
+        return explain::unique_ptr<T>(new std::remove_extent_t<T>[size]());
+    }
+
+    // default-initialized object - new T - no zeroing of trivial types
+    template <typename T>
+    std::enable_if_t<!std::is_array_v<T>, explain::unique_ptr<T>> make_unique_for_overwrite()
+    {
+        return explain::unique_ptr<T>(new T);
+    }
+
+    // array with default-initialized items - new T[size] - buffer is not zeroed before it is overwritten
+    template <typename T>
+    std::enable_if_t<std::is_array_v<T> && std::extent_v<T> == 0, explain::unique_ptr<T>> make_unique_for_overwrite(size_t size)
+    {
+        return explain::unique_ptr<T>(new std::remove_extent_t<T>[size]);
+    }
+
+    template <typename T, typename Deleter>
+    class unique_ptr<T[], Deleter>
+    {
+        detail::compressed_pair<T, Deleter> ptr_ {nullptr, Deleter {}};
 
     public:
         unique_ptr() = default;
 
         explicit unique_ptr(T* ptr)
-            : ptr_ {ptr}
+            : ptr_ {ptr, Deleter {}}
+        {
+        }
+
+        unique_ptr(T* ptr, Deleter deleter)
+            : ptr_ {ptr, std::move(deleter)}
         {
         }
 
         unique_ptr(nullptr_t)
-            : ptr_ {nullptr}
+            : ptr_ {nullptr, Deleter {}}
         {
         }
 
@@ -118,19 +262,16 @@ namespace explain
 
         // move constructor
         unique_ptr(unique_ptr&& other)
-            : ptr_ {other.ptr_}
+            : ptr_ {other.release(), std::move(other.get_deleter())}
         {
-            other.ptr_ = nullptr;
         }
 
         unique_ptr& operator=(unique_ptr&& other) // move assignment
         {
             if (this != &other) // avoiding self-assignment
             {
-                delete ptr_;
-
-                ptr_ = other.ptr_;
-                other.ptr_ = nullptr;
+                reset(other.release()); // delete[] by default deleter
+                get_deleter() = std::move(other.get_deleter());
             }
 
             return *this;
@@ -138,30 +279,65 @@ namespace explain
 
         ~unique_ptr()
         {
-            if (ptr_)
-                delete[] ptr_;
+            if (get())
+                get_deleter()(get());
+        }
+
+        T* get() const
+        {
+            return ptr_.pointer();
+        }
+
+        Deleter& get_deleter()
+        {
+            return ptr_.deleter();
+        }
+
+        T* release()
+        {
+            return std::exchange(ptr_.pointer(), nullptr);
+        }
+
+        void reset(T* ptr = nullptr)
+        {
+            T* old_ptr = std::exchange(ptr_.pointer(), ptr);
+            if (old_ptr)
+                get_deleter()(old_ptr);
         }
 
         T& operator*() const
         {
-            return *ptr_;
+            return *get();
         }
 
         T* operator->() const
         {
-            return ptr_;
+            return get();
         }
 
         T& operator[](size_t index) const
         {
-            return ptr_[index];
+            return get()[index];
         }
 
         explicit operator bool() const
         {
-            return ptr_ != nullptr;
+            return get() != nullptr;
+        }
+    };
+
+    struct FileCloser
+    {
+        void operator()(FILE* file) const
+        {
+            fclose(file);
         }
     };
+
+    static_assert(sizeof(unique_ptr<Gadget>) == sizeof(Gadget*));
+    static_assert(sizeof(unique_ptr<Gadget[]>) == sizeof(Gadget*));
+    static_assert(sizeof(unique_ptr<FILE, FileCloser>) == sizeof(FILE*));
+    static_assert(sizeof(unique_ptr<FILE, void (*)(FILE*)>) == 2 * sizeof(FILE*)); // pointer to function must be stored
 }
 
 TEST_CASE("unique_ptr & move semantics")
@@ -256,4 +432,81 @@ TEST_CASE("partial specialization for unique_ptr for arrays")
 
     tab[1] = 13;
 
-} // delete[] tab.ptr_
\ No newline at end of file
+    SECTION("make_unique for arrays value-initializes items")
+    {
+        auto zeros = explain::make_unique<int[]>(1024);
+
+        REQUIRE(std::all_of(zeros.get(), zeros.get() + 1024, [](int x) { return x == 0; }));
+    }
+
+    SECTION("make_unique_for_overwrite for arrays default-initializes items")
+    {
+        auto buffer = explain::make_unique_for_overwrite<char[]>(1024);
+        std::fill_n(buffer.get(), 1024, 'a');
+
+        REQUIRE(buffer[1023] == 'a');
+    }
+
+    SECTION("move assignment releases array with delete[]")
+    {
+        using CountedGadget = BasicGadget<CountingTracing>;
+        CountingTracing::reset();
+
+        auto gadgets = explain::make_unique<CountedGadget[]>(3);
+        gadgets = explain::make_unique<CountedGadget[]>(2);
+
+        REQUIRE(CountingTracing::counters().destructions == 3);
+    }
+} // delete[] tab.ptr_
+
+TEST_CASE("scratch buffers - make_unique vs. make_unique_for_overwrite", "[.][benchmark]")
+{
+    constexpr size_t size = 1024 * 1024;
+
+    BENCHMARK("make_unique<char[]>")
+    {
+        auto buffer = explain::make_unique<char[]>(size);
+        std::fill_n(buffer.get(), size, 'a');
+        return buffer[size - 1];
+    };
+
+    BENCHMARK("make_unique_for_overwrite<char[]>")
+    {
+        auto buffer = explain::make_unique_for_overwrite<char[]>(size);
+        std::fill_n(buffer.get(), size, 'a');
+        return buffer[size - 1];
+    };
+}
+
+TEST_CASE("unique_ptr with custom deleter")
+{
+    SECTION("stateless lambda")
+    {
+        auto file_closer = [](FILE* f) { fclose(f); };
+
+        explain::unique_ptr<FILE, decltype(file_closer)> file(tmpfile(), file_closer);
+        static_assert(sizeof(file) == sizeof(FILE*));
+
+        REQUIRE(fputs("text", file.get()) >= 0);
+    }
+
+    SECTION("function object")
+    {
+        explain::unique_ptr<FILE, explain::FileCloser> file(tmpfile());
+
+        REQUIRE(fputs("text", file.get()) >= 0);
+    }
+
+    SECTION("deleter with state is moved with the pointer")
+    {
+        int deleted = 0;
+        auto counting_deleter = [&deleted](Gadget* g) { ++deleted; delete g; };
+
+        explain::unique_ptr<Gadget, decltype(counting_deleter)> g1(new Gadget(1, "ipad"), counting_deleter);
+        explain::unique_ptr<Gadget, decltype(counting_deleter)> g2 = std::move(g1);
+        REQUIRE(deleted == 0);
+
+        g2.reset();
+        REQUIRE(deleted == 1);
+    }
+}
\ No newline at end of file
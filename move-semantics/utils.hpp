@@ -1,25 +1,389 @@
+#ifndef UTILS_HPP
+#define UTILS_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <cstring>
+#include <deque>
+#include <functional>
 #include <iostream>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
 #include <string>
 #include <string_view>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
 
 #define ENABLE_MOVE_SEMANTICS
 
+// Gadget lifecycle tracing (verbose output to std::cout by default):
+//#define GADGET_TRACING_SILENT   // no tracing at all
+//#define GADGET_TRACING_COUNTERS // only atomic counters of copies, moves & destructions
+
+// Gadget name storage (own std::string by default):
+//#define GADGET_INTERNED_NAMES   // 8-byte handle to a name stored in global StringPool
+
 namespace Utils
 {
+    /////////////////////////////////////////////////////////////////
+    // Formats values into a char buffer & passes every buffer-full to a sink
+    // - sink is a callable: void(const char* data, std::size_t size)
+    // - arithmetic types & strings are formatted without allocations (std::to_chars)
+    // - other types are formatted with their operator<< (through std::ostream writing to the same buffer)
+    //
+    template <typename Sink>
+    class BufferedFormatter : private std::streambuf
+    {
+        Sink sink_;
+        char* buffer_;
+        std::size_t capacity_;
+        std::optional<std::ostream> stream_;
+
+        static constexpr std::size_t max_number_length = 32;
+
+    public:
+        BufferedFormatter(Sink sink, char* buffer, std::size_t capacity)
+            : sink_ {std::move(sink)}
+            , buffer_ {buffer}
+            , capacity_ {capacity}
+        {
+            setp(buffer_, buffer_ + capacity_);
+        }
+
+        BufferedFormatter(const BufferedFormatter&) = delete;
+        BufferedFormatter& operator=(const BufferedFormatter&) = delete;
+
+        template <typename T>
+        BufferedFormatter& operator<<(const T& value)
+        {
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                put(value ? '1' : '0');
+            }
+            else if constexpr (std::is_same_v<T, char> || std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char>)
+            {
+                put(static_cast<char>(value));
+            }
+            else if constexpr (std::is_integral_v<T>)
+            {
+                reserve(max_number_length);
+                pbump(static_cast<int>(std::to_chars(pptr(), epptr(), value).ptr - pptr()));
+            }
+            else if constexpr (std::is_floating_point_v<T>)
+            {
+                reserve(max_number_length);
+                // the same as default formatting of std::ostream (%g)
+                pbump(static_cast<int>(std::to_chars(pptr(), epptr(), value, std::chars_format::general, 6).ptr - pptr()));
+            }
+            else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+            {
+                write(value);
+            }
+            else
+            {
+                if (!stream_)
+                    stream_.emplace(static_cast<std::streambuf*>(this));
+                *stream_ << value;
+            }
+
+            return *this;
+        }
+
+        void flush()
+        {
+            if (pptr() != pbase())
+            {
+                sink_(pbase(), static_cast<std::size_t>(pptr() - pbase()));
+                setp(buffer_, buffer_ + capacity_);
+            }
+        }
+
+    private:
+        void put(char c)
+        {
+            reserve(1);
+            *pptr() = c;
+            pbump(1);
+        }
+
+        void write(std::string_view text)
+        {
+            while (!text.empty())
+            {
+                if (pptr() == epptr())
+                    flush();
+
+                std::size_t chunk_size = std::min(text.size(), static_cast<std::size_t>(epptr() - pptr()));
+                std::memcpy(pptr(), text.data(), chunk_size);
+                pbump(static_cast<int>(chunk_size));
+                text.remove_prefix(chunk_size);
+            }
+        }
+
+        void reserve(std::size_t size)
+        {
+            if (static_cast<std::size_t>(epptr() - pptr()) < size)
+                flush();
+        }
+
+        int_type overflow(int_type c) override
+        {
+            flush();
+
+            if (!traits_type::eq_int_type(c, traits_type::eof()))
+                put(traits_type::to_char_type(c));
+
+            return traits_type::not_eof(c);
+        }
+
+        std::streamsize xsputn(const char* text, std::streamsize size) override
+        {
+            write(std::string_view(text, static_cast<std::size_t>(size)));
+            return size;
+        }
+    };
+
+    template <typename Container, typename Sink>
+    void print(const Container& container, std::string_view prefix, Sink sink)
+    {
+        thread_local std::array<char, 16 * 1024> buffer;
+
+        BufferedFormatter<Sink> formatter {std::move(sink), buffer.data(), buffer.size()};
+
+        formatter << prefix << ": [ ";
+        for (const auto& item : container)
+            formatter << item << ' ';
+        formatter << "]\n";
+
+        formatter.flush();
+    }
+
     template <typename Container>
     void print(const Container& container, std::string_view prefix)
     {
-        std::cout << prefix << ": [ ";
-        for (const auto& item : container)
-            std::cout << item << " ";
-        std::cout << "]" << std::endl;
+        print(container, prefix, [](const char* data, std::size_t size) { std::cout.write(data, size); });
+        std::cout.flush();
     }
 
-    class Gadget
+    /////////////////////////////////////////////////////////////////
+    // TracingPolicy - prints every special member function call
+    //
+    class VerboseTracing
+    {
+    public:
+        static void constructed(int id, std::string_view name)
+        {
+            std::cout << "Gadget(" << id << ", " << name << ")" << std::endl;
+        }
+
+        static void copy_constructed(int id, std::string_view name)
+        {
+            std::cout << "Gadget(cc: " << id << ", " << name << ")" << std::endl;
+        }
+
+        static void copy_assigned(int id, std::string_view name)
+        {
+            std::cout << "Gadget::operator=(cpy: " << id << ", " << name << ")" << std::endl;
+        }
+
+        static void move_constructed(int id, std::string_view name)
+        {
+            std::cout << "Gadget(mv: " << id << ", " << name << ")" << std::endl;
+        }
+
+        static void move_assigned(int id, std::string_view name)
+        {
+            std::cout << "Gadget::operator=(mv: " << id << ", " << name << ")" << std::endl;
+        }
+
+        static void destroyed(std::string_view name)
+        {
+            std::cout << "~Gadget(" << (name.empty() ? "after-move" : name) << ")" << std::endl;
+        }
+    };
+
+    /////////////////////////////////////////////////////////////////
+    // TracingPolicy - does nothing
+    //
+    class SilentTracing
+    {
+    public:
+        static void constructed(int, std::string_view) { }
+        static void copy_constructed(int, std::string_view) { }
+        static void copy_assigned(int, std::string_view) { }
+        static void move_constructed(int, std::string_view) { }
+        static void move_assigned(int, std::string_view) { }
+        static void destroyed(std::string_view) { }
+    };
+
+    /////////////////////////////////////////////////////////////////
+    // TracingPolicy - counts operations (thread-safe, no output)
+    //
+    class CountingTracing
+    {
+    public:
+        struct Counters
+        {
+            long constructions;
+            long copies;
+            long moves;
+            long destructions;
+        };
+
+        static Counters counters()
+        {
+            return {constructions_.load(), copies_.load(), moves_.load(), destructions_.load()};
+        }
+
+        static void reset()
+        {
+            constructions_ = 0;
+            copies_ = 0;
+            moves_ = 0;
+            destructions_ = 0;
+        }
+
+        static void constructed(int, std::string_view) { count(constructions_); }
+        static void copy_constructed(int, std::string_view) { count(copies_); }
+        static void copy_assigned(int, std::string_view) { count(copies_); }
+        static void move_constructed(int, std::string_view) { count(moves_); }
+        static void move_assigned(int, std::string_view) { count(moves_); }
+        static void destroyed(std::string_view) { count(destructions_); }
+
+    private:
+        inline static std::atomic<long> constructions_ {0};
+        inline static std::atomic<long> copies_ {0};
+        inline static std::atomic<long> moves_ {0};
+        inline static std::atomic<long> destructions_ {0};
+
+        static void count(std::atomic<long>& counter)
+        {
+            counter.fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+
+    /////////////////////////////////////////////////////////////////
+    // global, thread-safe pool of interned strings
+    // - interned strings live until the end of the program
+    //
+    class StringPool
+    {
+        struct Shard
+        {
+            std::shared_mutex mtx;
+            std::unordered_set<std::string_view> views;
+            std::deque<std::string> storage; // deque does not relocate strings - views stay valid
+        };
+
+        std::array<Shard, 16> shards_;
+
+    public:
+        static StringPool& instance()
+        {
+            static StringPool pool;
+            return pool;
+        }
+
+        // returns the same handle for equal texts
+        const std::string_view* intern(std::string_view text)
+        {
+            Shard& shard = shards_[std::hash<std::string_view> {}(text) % shards_.size()];
+
+            {
+                std::shared_lock lk {shard.mtx};
+
+                if (auto it = shard.views.find(text); it != shard.views.end())
+                    return &*it;
+            }
+
+            std::unique_lock lk {shard.mtx};
+
+            if (auto it = shard.views.find(text); it != shard.views.end())
+                return &*it;
+
+            const std::string& stored = shard.storage.emplace_back(text);
+            return &*shard.views.insert(stored).first;
+        }
+
+        static const std::string_view* empty()
+        {
+            static const std::string_view empty_text;
+            return &empty_text;
+        }
+    };
+
+    /////////////////////////////////////////////////////////////////
+    // NameStorage - gadget owns a copy of its name
+    //
+    class OwnedName
     {
-        int id_;
         std::string name_;
 
+    public:
+        explicit OwnedName(std::string_view name)
+            : name_ {name}
+        {
+        }
+
+        std::string value() const
+        {
+            return name_;
+        }
+
+        std::string_view view() const
+        {
+            return name_;
+        }
+    };
+
+    /////////////////////////////////////////////////////////////////
+    // NameStorage - gadget holds a handle to a name interned in StringPool
+    //
+    class InternedName
+    {
+        const std::string_view* handle_;
+
+    public:
+        explicit InternedName(std::string_view name)
+            : handle_ {StringPool::instance().intern(name)}
+        {
+        }
+
+        InternedName(const InternedName&) = default;
+        InternedName& operator=(const InternedName&) = default;
+
+        InternedName(InternedName&& source) noexcept
+            : handle_ {std::exchange(source.handle_, StringPool::empty())}
+        {
+        }
+
+        InternedName& operator=(InternedName&& source) noexcept
+        {
+            handle_ = std::exchange(source.handle_, StringPool::empty());
+            return *this;
+        }
+
+        std::string_view value() const
+        {
+            return *handle_;
+        }
+
+        std::string_view view() const
+        {
+            return *handle_;
+        }
+    };
+
+    template <typename TracingPolicy, typename NameStorage = OwnedName>
+    class BasicGadget
+    {
+        int id_;
+        NameStorage name_;
+
     public:
         static int gen_id()
         {
@@ -27,40 +391,40 @@ namespace Utils
             return ++id_seed;
         }
 
-        Gadget()
+        BasicGadget()
             : id_ {gen_id()}
             , name_ {"not-set"}
         {
-            std::cout << "Gadget(" << id_ << ", " << name_ << ")" << std::endl;
+            TracingPolicy::constructed(id_, name_.view());
         }
 
-        Gadget(int id, const std::string& name = "unknown")
+        BasicGadget(int id, std::string_view name = "unknown")
             : id_ {id}
             , name_ {name}
         {
-            std::cout << "Gadget(" << id_ << ", " << name_ << ")" << std::endl;
+            TracingPolicy::constructed(id_, name_.view());
         }
 
-        ~Gadget()
+        ~BasicGadget()
         {
-            std::cout << "~Gadget(" << (name_.empty() ? "after-move" : name_) << ")" << std::endl;
+            TracingPolicy::destroyed(name_.view());
         }
 
-        Gadget(const Gadget& source)
+        BasicGadget(const BasicGadget& source)
             : id_ {source.id_}
             , name_ {source.name_}
         {
-            std::cout << "Gadget(cc: " << id_ << ", " << name_ << ")" << std::endl;
+            TracingPolicy::copy_constructed(id_, name_.view());
         }
 
-        Gadget& operator=(const Gadget& source)
+        BasicGadget& operator=(const BasicGadget& source)
         {
             if (this != &source)
             {
                 id_ = source.id_;
                 name_ = source.name_;
 
-                std::cout << "Gadget::operator=(cpy: " << id_ << ", " << name_ << ")" << std::endl;
+                TracingPolicy::copy_assigned(id_, name_.view());
             }
 
             return *this;
@@ -68,24 +432,24 @@ namespace Utils
 
 #ifdef ENABLE_MOVE_SEMANTICS
 
-        Gadget(Gadget&& source) noexcept
+        BasicGadget(BasicGadget&& source) noexcept
             : id_ {source.id_}
             , name_ {std::move(source.name_)}
         {
             if (this != &source)
             {
-                std::cout << "Gadget(mv: " << id_ << ", " << name_ << ")" << std::endl;
+                TracingPolicy::move_constructed(id_, name_.view());
             }
         }
 
-        Gadget& operator=(Gadget&& source)
+        BasicGadget& operator=(BasicGadget&& source)
         {
             if (this != &source)
             {
                 id_ = source.id_;
                 name_ = std::move(source.name_);
 
-                std::cout << "Gadget::operator=(mv: " << id_ << ", " << name_ << ")" << std::endl;
+                TracingPolicy::move_assigned(id_, name_.view());
             }
 
             return *this;
@@ -97,15 +461,36 @@ namespace Utils
             return id_;
         }
 
-        std::string name() const
+        // std::string for OwnedName, std::string_view for InternedName
+        auto name() const
         {
-            return name_;
+            return name_.value();
         }
     };
 
-    inline std::ostream& operator<<(std::ostream& out, const Gadget& g)
+    template <typename TracingPolicy, typename NameStorage>
+    std::ostream& operator<<(std::ostream& out, const BasicGadget<TracingPolicy, NameStorage>& g)
     {
         out << "Gadget{id: " << g.id() << ", name: " << g.name() << "}";
         return out;
     }
-}
\ No newline at end of file
+
+#if defined(GADGET_TRACING_SILENT)
+    using DefaultTracing = SilentTracing;
+#elif defined(GADGET_TRACING_COUNTERS)
+    using DefaultTracing = CountingTracing;
+#else
+    using DefaultTracing = VerboseTracing;
+#endif
+
+#if defined(GADGET_INTERNED_NAMES)
+    using DefaultNameStorage = InternedName;
+#else
+    using DefaultNameStorage = OwnedName;
+#endif
+
+    using Gadget = BasicGadget<DefaultTracing, DefaultNameStorage>;
+    using InternedGadget = BasicGadget<DefaultTracing, InternedName>;
+}
+
+#endif // UTILS_HPP
@@ -0,0 +1,205 @@
+#ifndef EFFECT_CHAIN_HPP
+#define EFFECT_CHAIN_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/////////////////////////////////////////////////////////////////
+// Named effects stored contiguously in processing order
+// - lookup by std::string_view (binary search in sorted index) - no allocations
+// - reordering & erasing are O(n) moves inside vectors - no per-node allocations
+// - like std::vector: insertion may invalidate references to effects
+//
+template <typename T>
+class EffectChain
+{
+public:
+    struct Slot
+    {
+        std::string name;
+        T effect;
+    };
+
+    using iterator = typename std::vector<Slot>::iterator;
+    using const_iterator = typename std::vector<Slot>::const_iterator;
+
+private:
+    std::vector<Slot> slots_; // processing order
+    std::vector<std::uint32_t> index_; // positions of slots sorted by name
+
+public:
+    EffectChain() = default;
+
+    void reserve(std::size_t size)
+    {
+        slots_.reserve(size);
+        index_.reserve(size);
+    }
+
+    std::size_t size() const noexcept
+    {
+        return slots_.size();
+    }
+
+    bool empty() const noexcept
+    {
+        return slots_.empty();
+    }
+
+    iterator begin() noexcept
+    {
+        return slots_.begin();
+    }
+
+    iterator end() noexcept
+    {
+        return slots_.end();
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return slots_.begin();
+    }
+
+    const_iterator end() const noexcept
+    {
+        return slots_.end();
+    }
+
+    // returns nullptr if there is no effect with a given name
+    T* find(std::string_view name)
+    {
+        auto it = lower_bound(name);
+        return is_match(it, name) ? &slots_[*it].effect : nullptr;
+    }
+
+    const T* find(std::string_view name) const
+    {
+        return const_cast<EffectChain&>(*this).find(name);
+    }
+
+    bool contains(std::string_view name) const
+    {
+        return find(name) != nullptr;
+    }
+
+    // appends effect at the end of chain if name is not used yet
+    template <typename... TArgs>
+    std::pair<T*, bool> emplace(std::string_view name, TArgs&&... args)
+    {
+        auto it = lower_bound(name);
+
+        if (is_match(it, name))
+            return {&slots_[*it].effect, false};
+
+        slots_.push_back(Slot {std::string(name), T(std::forward<TArgs>(args)...)});
+
+        try
+        {
+            index_.insert(it, static_cast<std::uint32_t>(slots_.size() - 1));
+        }
+        catch (...)
+        {
+            slots_.pop_back(); // slot without an index entry could not be found or erased
+            throw;
+        }
+
+        return {&slots_.back().effect, true};
+    }
+
+    // like std::map::operator[] - appends default constructed effect if name is not used yet
+    T& operator[](std::string_view name)
+    {
+        return *emplace(name).first;
+    }
+
+    std::size_t position(std::string_view name) const
+    {
+        auto it = const_cast<EffectChain&>(*this).lower_bound(name);
+        return is_match(it, name) ? *it : size();
+    }
+
+    bool erase(std::string_view name)
+    {
+        auto it = lower_bound(name);
+
+        if (!is_match(it, name))
+            return false;
+
+        std::uint32_t erased_position = *it;
+        index_.erase(it);
+        slots_.erase(slots_.begin() + erased_position);
+
+        for (std::uint32_t& position : index_)
+            if (position > erased_position)
+                --position;
+
+        return true;
+    }
+
+    // moves effect to a new position in processing order
+    // - throws std::out_of_range if new_position >= size()
+    bool move_to(std::string_view name, std::size_t new_position)
+    {
+        if (new_position >= size())
+            throw std::out_of_range("Invalid position in effect chain");
+
+        auto it = lower_bound(name);
+
+        if (!is_match(it, name))
+            return false;
+
+        const std::uint32_t from = *it;
+        const auto to = static_cast<std::uint32_t>(new_position);
+
+        if (from < to)
+        {
+            std::rotate(slots_.begin() + from, slots_.begin() + from + 1, slots_.begin() + to + 1);
+
+            for (std::uint32_t& position : index_)
+                if (position == from)
+                    position = to;
+                else if (position > from && position <= to)
+                    --position;
+        }
+        else if (to < from)
+        {
+            std::rotate(slots_.begin() + to, slots_.begin() + from, slots_.begin() + from + 1);
+
+            for (std::uint32_t& position : index_)
+                if (position == from)
+                    position = to;
+                else if (position >= to && position < from)
+                    ++position;
+        }
+
+        return true;
+    }
+
+    void clear() noexcept
+    {
+        slots_.clear();
+        index_.clear();
+    }
+
+private:
+    std::vector<std::uint32_t>::iterator lower_bound(std::string_view name)
+    {
+        return std::lower_bound(index_.begin(), index_.end(), name, [this](std::uint32_t position, std::string_view key) {
+            return std::string_view(slots_[position].name) < key;
+        });
+    }
+
+    bool is_match(std::vector<std::uint32_t>::const_iterator it, std::string_view name) const
+    {
+        return it != index_.end() && slots_[*it].name == name;
+    }
+};
+
+#endif // EFFECT_CHAIN_HPP
@@ -0,0 +1,97 @@
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+#include "effect_chain.hpp"
+#include "instrumentation.hpp"
+#include "utils.hpp"
+
+using namespace Utils;
+using namespace std::literals;
+
+namespace
+{
+    template <typename T>
+    std::vector<std::string> names_of(const EffectChain<T>& effect_chain)
+    {
+        std::vector<std::string> names;
+        for (const auto& [name, effect] : effect_chain)
+            names.push_back(name);
+        return names;
+    }
+}
+
+TEST_CASE("effect chain")
+{
+    EffectChain<std::shared_ptr<Gadget>> effect_chain;
+
+    std::weak_ptr<Gadget> weak_overdrive_effect;
+
+    {
+        auto overdrive = std::make_shared<Gadget>(1, "boss overdrive");
+        weak_overdrive_effect = overdrive;
+
+        effect_chain.emplace("1st", overdrive);
+        REQUIRE(overdrive.use_count() == 2);
+    }
+
+    REQUIRE(effect_chain["1st"].use_count() == 1);
+    REQUIRE(effect_chain["1st"]->name() == "boss overdrive");
+
+    effect_chain["2nd"] = std::make_shared<Gadget>(2, "delay");
+    effect_chain["3rd"] = std::make_shared<Gadget>(3, "reverb");
+
+    REQUIRE(names_of(effect_chain) == std::vector {"1st"s, "2nd"s, "3rd"s});
+
+    SECTION("effects can't be duplicated")
+    {
+        auto [effect, inserted] = effect_chain.emplace("2nd", std::make_shared<Gadget>(4, "chorus"));
+
+        REQUIRE_FALSE(inserted);
+        REQUIRE((*effect)->name() == "delay");
+    }
+
+    SECTION("reordering")
+    {
+        effect_chain.move_to("3rd", 0);
+        REQUIRE(names_of(effect_chain) == std::vector {"3rd"s, "1st"s, "2nd"s});
+        REQUIRE(effect_chain.position("2nd") == 2);
+
+        effect_chain.move_to("3rd", 2);
+        REQUIRE(names_of(effect_chain) == std::vector {"1st"s, "2nd"s, "3rd"s});
+        REQUIRE(effect_chain["3rd"]->name() == "reverb");
+    }
+
+    SECTION("moving to invalid position throws")
+    {
+        REQUIRE_THROWS_AS(effect_chain.move_to("1st", 3), std::out_of_range);
+        REQUIRE(names_of(effect_chain) == std::vector {"1st"s, "2nd"s, "3rd"s});
+    }
+
+    SECTION("erase")
+    {
+        REQUIRE(effect_chain.erase("1st"));
+        REQUIRE_FALSE(effect_chain.erase("1st"));
+
+        REQUIRE(weak_overdrive_effect.expired());
+        REQUIRE(names_of(effect_chain) == std::vector {"2nd"s, "3rd"s});
+        REQUIRE(effect_chain["3rd"]->name() == "reverb");
+    }
+
+    SECTION("lookup by string_view does not allocate")
+    {
+        effect_chain["a name that does not fit into small string buffer"] = std::make_shared<Gadget>(5, "flanger");
+
+        Instrumentation::AllocationCounter allocations;
+
+        bool found = effect_chain.contains("a name that does not fit into small string buffer");
+        auto& flanger = effect_chain["a name that does not fit into small string buffer"];
+
+        auto allocs = allocations.allocations();
+        REQUIRE(found);
+        REQUIRE(flanger->name() == "flanger");
+        REQUIRE(allocs == 0);
+    }
+}
@@ -0,0 +1,263 @@
+#ifndef FILE_HANDLES_HPP
+#define FILE_HANDLES_HPP
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace Io
+{
+    /////////////////////////////////////////////////////////////////
+    // file descriptor as NullablePointer - may be stored in std::unique_ptr
+    //
+    class FileDescriptor
+    {
+        int fd_ = -1;
+
+    public:
+        FileDescriptor() = default;
+
+        FileDescriptor(std::nullptr_t) noexcept
+        {
+        }
+
+        FileDescriptor(int fd) noexcept
+            : fd_ {fd}
+        {
+        }
+
+        int get() const noexcept
+        {
+            return fd_;
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return fd_ != -1;
+        }
+
+        friend bool operator==(FileDescriptor a, FileDescriptor b) noexcept
+        {
+            return a.fd_ == b.fd_;
+        }
+
+        friend bool operator!=(FileDescriptor a, FileDescriptor b) noexcept
+        {
+            return a.fd_ != b.fd_;
+        }
+    };
+
+    struct FdCloser
+    {
+        using pointer = FileDescriptor;
+
+        void operator()(FileDescriptor fd) const noexcept
+        {
+            ::close(fd.get());
+        }
+    };
+
+    using UniqueFd = std::unique_ptr<FileDescriptor, FdCloser>;
+
+    inline UniqueFd open_fd(const char* path, int flags, mode_t mode = 0644)
+    {
+        int fd = ::open(path, flags, mode);
+
+        if (fd == -1)
+            throw std::system_error(errno, std::generic_category(), "open");
+
+        return UniqueFd(fd);
+    }
+
+    /////////////////////////////////////////////////////////////////
+    // memory-mapped region - deleter remembers the size of mapping
+    //
+    class Unmapper
+    {
+        std::size_t size_ = 0;
+
+    public:
+        Unmapper() = default;
+
+        explicit Unmapper(std::size_t size) noexcept
+            : size_ {size}
+        {
+        }
+
+        std::size_t size() const noexcept
+        {
+            return size_;
+        }
+
+        void operator()(std::byte* address) const noexcept
+        {
+            ::munmap(address, size_);
+        }
+    };
+
+    using MappedRegion = std::unique_ptr<std::byte[], Unmapper>;
+
+    inline MappedRegion map_file(const UniqueFd& fd, std::size_t size, int protection = PROT_READ, int flags = MAP_SHARED, off_t offset = 0)
+    {
+        void* address = ::mmap(nullptr, size, protection, flags, fd.get().get(), offset);
+
+        if (address == MAP_FAILED)
+            throw std::system_error(errno, std::generic_category(), "mmap");
+
+        return MappedRegion(static_cast<std::byte*>(address), Unmapper {size});
+    }
+
+    inline std::size_t file_size(const UniqueFd& fd)
+    {
+        struct stat info;
+
+        if (::fstat(fd.get().get(), &info) == -1)
+            throw std::system_error(errno, std::generic_category(), "fstat");
+
+        return static_cast<std::size_t>(info.st_size);
+    }
+
+    /////////////////////////////////////////////////////////////////
+    // Writer with large user-space buffer
+    // - small writes are copied to the buffer & written with one write() per buffer-full
+    // - data larger than the buffer is not copied - it is written together with
+    //   the buffered data by one writev() call
+    //
+    class BufferedWriter
+    {
+        UniqueFd fd_;
+        std::unique_ptr<char[]> buffer_;
+        std::size_t capacity_;
+        std::size_t size_ = 0;
+
+    public:
+        explicit BufferedWriter(UniqueFd fd, std::size_t buffer_size = 1024 * 1024)
+            : fd_ {std::move(fd)}
+            , buffer_ {new char[buffer_size]} // not zeroed
+            , capacity_ {buffer_size}
+        {
+        }
+
+        BufferedWriter(BufferedWriter&& other) noexcept
+            : fd_ {std::move(other.fd_)}
+            , buffer_ {std::move(other.buffer_)}
+            , capacity_ {std::exchange(other.capacity_, 0)}
+            , size_ {std::exchange(other.size_, 0)}
+        {
+        }
+
+        // buffered data of the target is flushed before it is replaced
+        BufferedWriter& operator=(BufferedWriter&& other)
+        {
+            if (this != &other)
+            {
+                if (fd_)
+                    flush();
+
+                fd_ = std::move(other.fd_);
+                buffer_ = std::move(other.buffer_);
+                capacity_ = std::exchange(other.capacity_, 0);
+                size_ = std::exchange(other.size_, 0);
+            }
+
+            return *this;
+        }
+
+        ~BufferedWriter()
+        {
+            try
+            {
+                if (fd_)
+                    flush();
+            }
+            catch (...)
+            {
+                // call flush() explicitly to handle errors
+            }
+        }
+
+        void write(const void* data, std::size_t size)
+        {
+            if (size <= capacity_ - size_)
+            {
+                std::memcpy(buffer_.get() + size_, data, size);
+                size_ += size;
+            }
+            else if (size >= capacity_)
+            {
+                iovec chunks[] = {{buffer_.get(), size_}, {const_cast<void*>(data), size}};
+                write_all(chunks, 2);
+                size_ = 0;
+            }
+            else
+            {
+                flush();
+                std::memcpy(buffer_.get(), data, size);
+                size_ = size;
+            }
+        }
+
+        void write(std::string_view text)
+        {
+            write(text.data(), text.size());
+        }
+
+        void flush()
+        {
+            iovec chunk = {buffer_.get(), size_};
+            write_all(&chunk, 1);
+            size_ = 0;
+        }
+
+        // flushes buffer & returns file descriptor
+        UniqueFd release()
+        {
+            flush();
+            return std::move(fd_);
+        }
+
+    private:
+        void write_all(iovec* chunks, int count)
+        {
+            while (count > 0)
+            {
+                ssize_t written = ::writev(fd_.get().get(), chunks, count);
+
+                if (written == -1)
+                {
+                    if (errno == EINTR)
+                        continue;
+
+                    throw std::system_error(errno, std::generic_category(), "writev");
+                }
+
+                // skip fully written chunks & adjust partially written one
+                auto remaining = static_cast<std::size_t>(written);
+                while (count > 0 && remaining >= chunks->iov_len)
+                {
+                    remaining -= chunks->iov_len;
+                    ++chunks;
+                    --count;
+                }
+
+                if (count > 0)
+                {
+                    chunks->iov_base = static_cast<char*>(chunks->iov_base) + remaining;
+                    chunks->iov_len -= remaining;
+                }
+            }
+        }
+    };
+}
+
+#endif // FILE_HANDLES_HPP
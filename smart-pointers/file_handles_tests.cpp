@@ -0,0 +1,126 @@
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+#include "file_handles.hpp"
+
+using namespace Io;
+
+namespace
+{
+    struct TempFile
+    {
+        std::string path = "/tmp/smart-pointers-XXXXXX";
+        UniqueFd fd;
+
+        TempFile()
+            : fd {::mkstemp(path.data())}
+        {
+            if (!fd)
+                throw std::system_error(errno, std::generic_category(), "mkstemp");
+        }
+
+        ~TempFile()
+        {
+            ::unlink(path.c_str());
+        }
+    };
+
+    std::string read_all(const std::string& path)
+    {
+        UniqueFd fd = open_fd(path.c_str(), O_RDONLY);
+        MappedRegion region = map_file(fd, file_size(fd));
+
+        return std::string(reinterpret_cast<const char*>(region.get()), region.get_deleter().size());
+    }
+}
+
+static_assert(sizeof(UniqueFd) == sizeof(int));
+
+TEST_CASE("RAII file descriptors & mapped regions")
+{
+    TempFile file;
+
+    SECTION("buffered writes")
+    {
+        BufferedWriter writer {std::move(file.fd), 16};
+
+        writer.write("Hello, ");
+        writer.write("buffered ");
+        writer.write("world!");
+        writer.flush();
+
+        REQUIRE(read_all(file.path) == "Hello, buffered world!");
+    }
+
+    SECTION("large write goes directly to the file with buffered data")
+    {
+        BufferedWriter writer {std::move(file.fd), 16};
+
+        const std::string large(100, 'x');
+
+        writer.write("header|");
+        writer.write(large);
+        writer.write("|footer");
+        writer.release();
+
+        REQUIRE(read_all(file.path) == "header|" + large + "|footer");
+    }
+
+    SECTION("move assignment flushes buffered data of the target")
+    {
+        TempFile other_file;
+
+        BufferedWriter writer {std::move(file.fd), 16};
+        writer.write("first");
+
+        BufferedWriter other_writer {std::move(other_file.fd), 16};
+        other_writer.write("second");
+
+        writer = std::move(other_writer);
+        writer.flush();
+
+        REQUIRE(read_all(file.path) == "first");
+        REQUIRE(read_all(other_file.path) == "second");
+    }
+
+    SECTION("opening not existing file throws")
+    {
+        REQUIRE_THROWS_AS(open_fd("/not/existing/file", O_RDONLY), std::system_error);
+    }
+}
+
+TEST_CASE("BufferedWriter vs. fwrite - throughput", "[.][benchmark]")
+{
+    constexpr size_t total_size = 64 * 1024 * 1024;
+
+    for (size_t record_size : {64, 4096, 1024 * 1024})
+    {
+        const std::vector<char> record(record_size, 'x');
+        const std::string suffix = " - " + std::to_string(record_size) + " B records";
+
+        BENCHMARK("fopen/fwrite" + suffix)
+        {
+            TempFile file;
+            FILE* f = std::fopen(file.path.c_str(), "w");
+
+            for (size_t written = 0; written < total_size; written += record_size)
+                fwrite(record.data(), 1, record_size, f);
+
+            return fclose(f);
+        };
+
+        BENCHMARK("BufferedWriter" + suffix)
+        {
+            TempFile file;
+            BufferedWriter writer {open_fd(file.path.c_str(), O_WRONLY | O_TRUNC)}; // opened like fopen(path, "w")
+
+            for (size_t written = 0; written < total_size; written += record_size)
+                writer.write(record.data(), record_size);
+
+            return writer.release().get().get();
+        };
+    }
+}
@@ -0,0 +1,158 @@
+#ifndef INSTRUMENTATION_HPP
+#define INSTRUMENTATION_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include "utils.hpp"
+
+// Optional global operator new/delete hook:
+// define INSTRUMENTATION_HOOK_GLOBAL_NEW in exactly one translation unit of the program
+// before including this header - AllocationCounter reports zeros otherwise.
+
+namespace Instrumentation
+{
+    // Gadget that counts (instead of printing) all copies & moves
+    using InstrumentedGadget = Utils::BasicGadget<Utils::CountingTracing>;
+
+    /////////////////////////////////////////////////////////////////
+    // counts operations on InstrumentedGadgets made during the lifetime of a counter
+    //
+    class OperationsCounter
+    {
+        Utils::CountingTracing::Counters start_;
+
+    public:
+        OperationsCounter()
+            : start_ {Utils::CountingTracing::counters()}
+        {
+        }
+
+        long constructions() const
+        {
+            return Utils::CountingTracing::counters().constructions - start_.constructions;
+        }
+
+        long copies() const
+        {
+            return Utils::CountingTracing::counters().copies - start_.copies;
+        }
+
+        long moves() const
+        {
+            return Utils::CountingTracing::counters().moves - start_.moves;
+        }
+
+        long destructions() const
+        {
+            return Utils::CountingTracing::counters().destructions - start_.destructions;
+        }
+    };
+
+    namespace Detail
+    {
+        inline thread_local std::size_t allocations = 0;
+        inline thread_local std::size_t deallocations = 0;
+        inline thread_local std::size_t allocated_bytes = 0;
+    }
+
+    /////////////////////////////////////////////////////////////////
+    // counts dynamic allocations made by the current thread during the lifetime of a counter
+    //
+    class AllocationCounter
+    {
+        std::size_t allocations_ = Detail::allocations;
+        std::size_t deallocations_ = Detail::deallocations;
+        std::size_t bytes_ = Detail::allocated_bytes;
+
+    public:
+        std::size_t allocations() const
+        {
+            return Detail::allocations - allocations_;
+        }
+
+        std::size_t deallocations() const
+        {
+            return Detail::deallocations - deallocations_;
+        }
+
+        std::size_t bytes() const
+        {
+            return Detail::allocated_bytes - bytes_;
+        }
+    };
+}
+
+#ifdef INSTRUMENTATION_HOOK_GLOBAL_NEW
+
+void* operator new(std::size_t size)
+{
+    ++Instrumentation::Detail::allocations;
+    Instrumentation::Detail::allocated_bytes += size;
+
+    if (void* ptr = std::malloc(size == 0 ? 1 : size))
+        return ptr;
+
+    throw std::bad_alloc {};
+}
+
+void* operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    try
+    {
+        return ::operator new(size);
+    }
+    catch (const std::bad_alloc&)
+    {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return ::operator new(size, std::nothrow);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    if (ptr)
+    {
+        ++Instrumentation::Detail::deallocations;
+        std::free(ptr);
+    }
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    ::operator delete(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    ::operator delete(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    ::operator delete(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    ::operator delete(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+    ::operator delete(ptr);
+}
+
+#endif // INSTRUMENTATION_HOOK_GLOBAL_NEW
+
+#endif // INSTRUMENTATION_HPP
@@ -0,0 +1,65 @@
+#define INSTRUMENTATION_HOOK_GLOBAL_NEW
+
+#include <memory>
+#include <vector>
+
+#include "catch.hpp"
+#include "instrumentation.hpp"
+
+using namespace Instrumentation;
+
+TEST_CASE("zero-copy hot paths - unique_ptr")
+{
+    auto g = std::make_unique<InstrumentedGadget>(1, "reverb");
+
+    std::vector<std::unique_ptr<InstrumentedGadget>> gadgets;
+    gadgets.reserve(10);
+
+    OperationsCounter operations;
+    AllocationCounter allocations;
+
+    gadgets.push_back(std::move(g));
+
+    auto allocs = allocations.allocations();
+    REQUIRE(operations.copies() == 0);
+    REQUIRE(operations.moves() == 0);
+    REQUIRE(allocs == 0);
+}
+
+TEST_CASE("zero-copy hot paths - shared_ptr")
+{
+    SECTION("make_shared allocates object & control block at once")
+    {
+        AllocationCounter allocations;
+
+        auto sp = std::make_shared<InstrumentedGadget>(1, "reverb");
+
+        auto allocs = allocations.allocations();
+        REQUIRE(allocs == 1);
+    }
+
+    SECTION("shared_ptr(new T) allocates control block separately")
+    {
+        AllocationCounter allocations;
+
+        std::shared_ptr<InstrumentedGadget> sp(new InstrumentedGadget(1, "reverb"));
+
+        auto allocs = allocations.allocations();
+        REQUIRE(allocs == 2);
+    }
+
+    SECTION("copy of shared_ptr neither copies gadget nor allocates")
+    {
+        auto sp = std::make_shared<InstrumentedGadget>(1, "reverb");
+
+        OperationsCounter operations;
+        AllocationCounter allocations;
+
+        std::shared_ptr<InstrumentedGadget> another = sp;
+
+        auto allocs = allocations.allocations();
+        REQUIRE(operations.copies() == 0);
+        REQUIRE(allocs == 0);
+        REQUIRE(sp.use_count() == 2);
+    }
+}
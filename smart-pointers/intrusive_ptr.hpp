@@ -0,0 +1,161 @@
+#ifndef INTRUSIVE_PTR_HPP
+#define INTRUSIVE_PTR_HPP
+
+#include <cstddef>
+#include <utility>
+
+#include "ref_count.hpp"
+
+namespace Memory
+{
+    /////////////////////////////////////////////////////////////////
+    // Mixin - reference counter embedded in an object of class T (CRTP)
+    //
+    template <typename T, typename RefCountPolicy = AtomicRefCount>
+    class RefCounted
+    {
+        mutable RefCountPolicy ref_count_ {0};
+
+        friend void intrusive_ptr_add_ref(const RefCounted* ptr) noexcept
+        {
+            ptr->ref_count_.increment();
+        }
+
+        friend void intrusive_ptr_release(const RefCounted* ptr) noexcept
+        {
+            if (ptr->ref_count_.decrement() != 0)
+                return;
+
+            destroy(ptr);
+        }
+
+        // cold path - out of line (inlined delete triggers false -Wuse-after-free in GCC 12)
+        [[gnu::noinline]] static void destroy(const RefCounted* ptr) noexcept
+        {
+            delete static_cast<const T*>(ptr);
+        }
+
+    public:
+        long use_count() const noexcept
+        {
+            return ref_count_.load();
+        }
+
+    protected:
+        RefCounted() = default;
+
+        // copy of an object is not owned by owners of the source
+        RefCounted(const RefCounted&) noexcept
+        {
+        }
+
+        RefCounted& operator=(const RefCounted&) noexcept
+        {
+            return *this;
+        }
+
+        ~RefCounted() = default;
+    };
+
+    /////////////////////////////////////////////////////////////////
+    // Smart pointer to an object with embedded reference counter
+    // - T must provide intrusive_ptr_add_ref() & intrusive_ptr_release() (found by ADL)
+    //
+    template <typename T>
+    class intrusive_ptr
+    {
+        T* ptr_ = nullptr;
+
+    public:
+        intrusive_ptr() = default;
+
+        intrusive_ptr(std::nullptr_t) noexcept
+        {
+        }
+
+        explicit intrusive_ptr(T* ptr) noexcept
+            : ptr_ {ptr}
+        {
+            if (ptr_)
+                intrusive_ptr_add_ref(ptr_);
+        }
+
+        intrusive_ptr(const intrusive_ptr& other) noexcept
+            : ptr_ {other.ptr_}
+        {
+            if (ptr_)
+                intrusive_ptr_add_ref(ptr_);
+        }
+
+        intrusive_ptr& operator=(const intrusive_ptr& other) noexcept
+        {
+            intrusive_ptr(other).swap(*this);
+            return *this;
+        }
+
+        intrusive_ptr(intrusive_ptr&& other) noexcept
+            : ptr_ {std::exchange(other.ptr_, nullptr)}
+        {
+        }
+
+        intrusive_ptr& operator=(intrusive_ptr&& other) noexcept
+        {
+            intrusive_ptr(std::move(other)).swap(*this);
+            return *this;
+        }
+
+        ~intrusive_ptr()
+        {
+            if (ptr_)
+                intrusive_ptr_release(ptr_);
+        }
+
+        void swap(intrusive_ptr& other) noexcept
+        {
+            std::swap(ptr_, other.ptr_);
+        }
+
+        void reset() noexcept
+        {
+            intrusive_ptr().swap(*this);
+        }
+
+        T* get() const noexcept
+        {
+            return ptr_;
+        }
+
+        T& operator*() const noexcept
+        {
+            return *ptr_;
+        }
+
+        T* operator->() const noexcept
+        {
+            return ptr_;
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return ptr_ != nullptr;
+        }
+
+        bool operator==(const intrusive_ptr& other) const noexcept
+        {
+            return ptr_ == other.ptr_;
+        }
+
+        bool operator!=(const intrusive_ptr& other) const noexcept
+        {
+            return ptr_ != other.ptr_;
+        }
+    };
+
+    template <typename T, typename... TArgs>
+    intrusive_ptr<T> make_intrusive(TArgs&&... args)
+    {
+        return intrusive_ptr<T>(new T(std::forward<TArgs>(args)...));
+    }
+}
+
+#endif // INTRUSIVE_PTR_HPP
@@ -0,0 +1,120 @@
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch.hpp"
+#include "intrusive_ptr.hpp"
+#include "utils.hpp"
+
+using namespace Utils;
+using namespace Memory;
+
+template <typename TGadget, typename RefCountPolicy = AtomicRefCount>
+class RefCountedGadget : public TGadget, public RefCounted<RefCountedGadget<TGadget, RefCountPolicy>, RefCountPolicy>
+{
+public:
+    using TGadget::TGadget;
+};
+
+static_assert(sizeof(intrusive_ptr<RefCountedGadget<Gadget>>) == sizeof(void*));
+
+TEST_CASE("intrusive_ptr")
+{
+    using SharedGadget = RefCountedGadget<Gadget>;
+
+    std::map<std::string, intrusive_ptr<SharedGadget>> effect_chain;
+
+    {
+        auto overdrive = make_intrusive<SharedGadget>(1, "boss overdrive"); // RC: 1
+
+        auto another_ip = overdrive; // RC: 2
+        REQUIRE(overdrive->use_count() == 2);
+
+        effect_chain.emplace("1st", overdrive); // RC: 3
+        REQUIRE(overdrive->use_count() == 3);
+    } // RC: 1
+
+    REQUIRE(effect_chain["1st"]->use_count() == 1);
+    REQUIRE(effect_chain["1st"]->name() == "boss overdrive");
+
+    SECTION("raw pointer can be adopted again - counter is a part of object")
+    {
+        SharedGadget* raw_ptr = effect_chain["1st"].get();
+
+        intrusive_ptr<SharedGadget> adopted(raw_ptr);
+        REQUIRE(adopted->use_count() == 2);
+    }
+
+    SECTION("copy of object has its own counter")
+    {
+        SharedGadget copy = *effect_chain["1st"];
+        REQUIRE(copy.use_count() == 0);
+    }
+
+    SECTION("non-atomic counter")
+    {
+        auto reverb = make_intrusive<RefCountedGadget<Gadget, PlainRefCount>>(2, "reverb");
+        auto another = reverb;
+
+        REQUIRE(reverb->use_count() == 2);
+    }
+
+    effect_chain.clear(); // RC: 0 - gadget is deleted
+}
+
+namespace
+{
+    template <typename TPtr, typename TFactory>
+    std::map<std::string, TPtr> create_effect_chain(TFactory factory)
+    {
+        std::map<std::string, TPtr> effect_chain;
+        for (int i = 0; i < 100; ++i)
+            effect_chain.emplace("effect#" + std::to_string(i), factory(i));
+        return effect_chain;
+    }
+
+    template <typename TPtr>
+    size_t copy_and_destroy(const std::map<std::string, TPtr>& effect_chain)
+    {
+        std::vector<TPtr> copies;
+        copies.reserve(effect_chain.size());
+
+        for (const auto& [name, effect] : effect_chain)
+            copies.push_back(effect);
+
+        return copies.size();
+    }
+}
+
+TEST_CASE("intrusive_ptr vs. shared_ptr - copy & destroy", "[.][benchmark]")
+{
+    using SilentGadget = BasicGadget<SilentTracing>;
+
+    // libstdc++ skips atomic operations in shared_ptr until the first thread is started
+    std::thread {[] {}}.join();
+
+    auto shared_chain = create_effect_chain<std::shared_ptr<SilentGadget>>([](int id) { return std::make_shared<SilentGadget>(id); });
+
+    using AtomicGadget = RefCountedGadget<SilentGadget, AtomicRefCount>;
+    auto atomic_chain = create_effect_chain<intrusive_ptr<AtomicGadget>>([](int id) { return make_intrusive<AtomicGadget>(id); });
+
+    using PlainGadget = RefCountedGadget<SilentGadget, PlainRefCount>;
+    auto plain_chain = create_effect_chain<intrusive_ptr<PlainGadget>>([](int id) { return make_intrusive<PlainGadget>(id); });
+
+    BENCHMARK("std::shared_ptr")
+    {
+        return copy_and_destroy(shared_chain);
+    };
+
+    BENCHMARK("intrusive_ptr - atomic counter")
+    {
+        return copy_and_destroy(atomic_chain);
+    };
+
+    BENCHMARK("intrusive_ptr - plain counter")
+    {
+        return copy_and_destroy(plain_chain);
+    };
+}
@@ -0,0 +1,321 @@
+#ifndef OBJECT_POOL_HPP
+#define OBJECT_POOL_HPP
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Memory
+{
+    /////////////////////////////////////////////////////////////////
+    // Pool of fixed-size blocks:
+    // - every thread allocates from & deallocates to its own free list (no locking)
+    // - surplus of blocks is moved in batches to a global overflow list (guarded by mutex)
+    // - memory is obtained from the heap in chunks & never returned - the global pool is never destroyed,
+    //   so pooled objects may be freed during static destruction
+    // - blocks freed by a thread after destruction of its cache go directly to the global pool
+    //
+    template <std::size_t BlockSize, std::size_t Alignment = alignof(std::max_align_t)>
+    class FixedSizePool
+    {
+        struct FreeBlock
+        {
+            FreeBlock* next;
+        };
+
+        static_assert(Alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "over-aligned types are not supported");
+
+        static constexpr std::size_t alignment = Alignment < alignof(FreeBlock) ? alignof(FreeBlock) : Alignment;
+        static constexpr std::size_t block_size = ((BlockSize < sizeof(FreeBlock) ? sizeof(FreeBlock) : BlockSize) + alignment - 1) / alignment * alignment;
+        static constexpr std::size_t batch_size = 256;
+
+        struct Batch
+        {
+            FreeBlock* head;
+            std::size_t count;
+        };
+
+        class GlobalPool
+        {
+            std::mutex mtx_;
+            std::vector<Batch> batches_;
+            std::vector<void*> chunks_;
+
+        public:
+            GlobalPool() = default;
+            GlobalPool(const GlobalPool&) = delete;
+            GlobalPool& operator=(const GlobalPool&) = delete;
+
+            Batch take()
+            {
+                std::lock_guard lk {mtx_};
+
+                if (!batches_.empty())
+                {
+                    Batch batch = batches_.back();
+                    batches_.pop_back();
+                    return batch;
+                }
+
+                return allocate_chunk();
+            }
+
+            void give_back(Batch batch)
+            {
+                std::lock_guard lk {mtx_};
+                batches_.push_back(batch);
+            }
+
+        private:
+            Batch allocate_chunk()
+            {
+                auto* chunk = static_cast<std::byte*>(::operator new(block_size * batch_size));
+                chunks_.push_back(chunk);
+
+                FreeBlock* head = nullptr;
+                for (std::size_t i = batch_size; i > 0; --i)
+                {
+                    auto* block = reinterpret_cast<FreeBlock*>(chunk + (i - 1) * block_size);
+                    block->next = head;
+                    head = block;
+                }
+
+                return Batch {head, batch_size};
+            }
+        };
+
+        class LocalCache
+        {
+            Batch free_ {nullptr, 0};
+
+        public:
+            LocalCache() = default;
+            LocalCache(const LocalCache&) = delete;
+            LocalCache& operator=(const LocalCache&) = delete;
+
+            ~LocalCache()
+            {
+                local_destroyed() = true;
+
+                if (free_.count > 0)
+                    global().give_back(free_);
+            }
+
+            void* allocate()
+            {
+                if (free_.count == 0)
+                    free_ = global().take();
+
+                FreeBlock* block = free_.head;
+                free_.head = block->next;
+                --free_.count;
+
+                return block;
+            }
+
+            void deallocate(void* ptr) noexcept
+            {
+                auto* block = static_cast<FreeBlock*>(ptr);
+                block->next = free_.head;
+                free_.head = block;
+
+                if (++free_.count == 2 * batch_size)
+                    global().give_back(split_batch());
+            }
+
+        private:
+            Batch split_batch()
+            {
+                FreeBlock* head = free_.head;
+                FreeBlock* last = head;
+                for (std::size_t i = 1; i < batch_size; ++i)
+                    last = last->next;
+
+                free_.head = last->next;
+                free_.count -= batch_size;
+                last->next = nullptr;
+
+                return Batch {head, batch_size};
+            }
+        };
+
+        static GlobalPool& global()
+        {
+            static GlobalPool& pool = *new GlobalPool; // intentionally leaked - see above
+            return pool;
+        }
+
+        static LocalCache& local()
+        {
+            thread_local LocalCache cache;
+            return cache;
+        }
+
+        // trivially destructible - may be checked after the cache of the thread has been destroyed
+        static bool& local_destroyed()
+        {
+            thread_local bool destroyed = false;
+            return destroyed;
+        }
+
+    public:
+        static void* allocate()
+        {
+            if (local_destroyed())
+                return ::operator new(block_size); // block joins the pool when it is deallocated
+
+            return local().allocate();
+        }
+
+        static void deallocate(void* ptr) noexcept
+        {
+            if (local_destroyed())
+            {
+                auto* block = static_cast<FreeBlock*>(ptr);
+                block->next = nullptr;
+                global().give_back(Batch {block, 1});
+            }
+            else
+                local().deallocate(ptr);
+        }
+    };
+
+    /////////////////////////////////////////////////////////////////
+    // Mixin - class-specific operator new/delete using FixedSizePool
+    //
+    template <typename T>
+    class PoolAllocated
+    {
+    public:
+        static void* operator new(std::size_t size)
+        {
+            if (size != sizeof(T)) // class derived from T
+                return ::operator new(size);
+
+            return FixedSizePool<sizeof(T), alignof(T)>::allocate();
+        }
+
+        static void operator delete(void* ptr, std::size_t size) noexcept
+        {
+            if (size != sizeof(T))
+                ::operator delete(ptr);
+            else
+                FixedSizePool<sizeof(T), alignof(T)>::deallocate(ptr);
+        }
+
+    protected:
+        ~PoolAllocated() = default;
+    };
+
+    /////////////////////////////////////////////////////////////////
+    // T with pooled allocation - usable with new/delete & std::make_unique
+    // - T must have a virtual destructor: unique_ptr<Pooled<T>> converts to unique_ptr<T>
+    //   & deletion through T* must reach operator delete of Pooled<T>
+    // - for other types use make_pooled_unique()
+    // - limitation: Gadget has no virtual destructor, so Pooled<Gadget> doesn't compile; pooled gadgets
+    //   are owned by PooledPtr<Gadget>, which is not a std::unique_ptr<Gadget> - factories returning
+    //   std::unique_ptr<Gadget> (e.g. modern_cpp::effect_factory) can't use the pool without changing their return type
+    //
+    template <typename T>
+    class Pooled : public T, public PoolAllocated<Pooled<T>>
+    {
+        static_assert(std::has_virtual_destructor_v<T>, "Pooled<T> requires virtual destructor of T - use make_pooled_unique<T>()");
+
+    public:
+        using T::T;
+    };
+
+    /////////////////////////////////////////////////////////////////
+    // Deleter returning memory of an object to FixedSizePool
+    // - PooledPtr<T> does not convert to std::unique_ptr<T>, so the block can't reach ::operator delete
+    //
+    template <typename T>
+    struct PoolDeleter
+    {
+        void operator()(T* ptr) const noexcept
+        {
+            static_assert(sizeof(T) > 0, "can't delete an incomplete type");
+
+            ptr->~T();
+            FixedSizePool<sizeof(T), alignof(T)>::deallocate(ptr);
+        }
+    };
+
+    template <typename T>
+    using PooledPtr = std::unique_ptr<T, PoolDeleter<T>>;
+
+    // std::make_unique with object allocated from a pool
+    template <typename T, typename... TArgs>
+    PooledPtr<T> make_pooled_unique(TArgs&&... args)
+    {
+        void* memory = FixedSizePool<sizeof(T), alignof(T)>::allocate();
+
+        try
+        {
+            return PooledPtr<T> {new (memory) T(std::forward<TArgs>(args)...)};
+        }
+        catch (...)
+        {
+            FixedSizePool<sizeof(T), alignof(T)>::deallocate(memory);
+            throw;
+        }
+    }
+
+    /////////////////////////////////////////////////////////////////
+    // Allocator using FixedSizePool for single objects - usable with std::allocate_shared
+    //
+    template <typename T>
+    class PoolAllocator
+    {
+    public:
+        using value_type = T;
+
+        PoolAllocator() = default;
+
+        template <typename U>
+        PoolAllocator(const PoolAllocator<U>&) noexcept
+        {
+        }
+
+        T* allocate(std::size_t n)
+        {
+            if (n != 1)
+                return static_cast<T*>(::operator new(n * sizeof(T)));
+
+            return static_cast<T*>(FixedSizePool<sizeof(T), alignof(T)>::allocate());
+        }
+
+        void deallocate(T* ptr, std::size_t n) noexcept
+        {
+            if (n != 1)
+                ::operator delete(ptr);
+            else
+                FixedSizePool<sizeof(T), alignof(T)>::deallocate(ptr);
+        }
+
+        template <typename U>
+        bool operator==(const PoolAllocator<U>&) const noexcept
+        {
+            return true;
+        }
+
+        template <typename U>
+        bool operator!=(const PoolAllocator<U>&) const noexcept
+        {
+            return false;
+        }
+    };
+
+    // std::make_shared with object & control block allocated from a pool
+    template <typename T, typename... TArgs>
+    std::shared_ptr<T> make_pooled_shared(TArgs&&... args)
+    {
+        return std::allocate_shared<T>(PoolAllocator<T> {}, std::forward<TArgs>(args)...);
+    }
+}
+
+#endif // OBJECT_POOL_HPP
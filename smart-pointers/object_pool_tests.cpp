@@ -0,0 +1,159 @@
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "catch.hpp"
+#include "object_pool.hpp"
+#include "utils.hpp"
+
+using namespace Utils;
+using namespace Memory;
+
+namespace modern_cpp
+{
+    PooledPtr<Gadget> pooled_effect_factory(const std::string& name)
+    {
+        static int id = 665;
+        return make_pooled_unique<Gadget>(++id, name);
+    }
+
+    class Effect
+    {
+    public:
+        virtual ~Effect() = default;
+        virtual std::string name() const = 0;
+    };
+
+    class Reverb : public Effect
+    {
+        int room_size_;
+
+    public:
+        explicit Reverb(int room_size)
+            : room_size_ {room_size}
+        {
+        }
+
+        std::string name() const override
+        {
+            return "reverb-" + std::to_string(room_size_);
+        }
+    };
+}
+
+TEST_CASE("pooled gadgets")
+{
+    SECTION("memory of deleted gadget is reused")
+    {
+        auto fractal = modern_cpp::pooled_effect_factory("fractal");
+        void* address = fractal.get();
+        fractal.reset();
+
+        auto kemper = modern_cpp::pooled_effect_factory("kemper");
+        REQUIRE(kemper.get() == address);
+        REQUIRE(kemper->name() == "kemper");
+    }
+
+    SECTION("gadgets from pool are distinct objects")
+    {
+        std::vector<PooledPtr<Gadget>> gadgets;
+        std::set<void*> addresses;
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            gadgets.push_back(make_pooled_unique<Gadget>(i));
+            addresses.insert(gadgets.back().get());
+        }
+
+        REQUIRE(addresses.size() == 1000);
+    }
+
+    SECTION("gadget may be freed by another thread")
+    {
+        using SilentGadget = BasicGadget<SilentTracing>;
+
+        std::vector<PooledPtr<SilentGadget>> gadgets;
+        for (int i = 0; i < 1000; ++i)
+            gadgets.push_back(make_pooled_unique<SilentGadget>(i));
+
+        std::thread thd {[gadgets = std::move(gadgets)]() mutable { gadgets.clear(); }};
+        thd.join();
+
+        auto g = make_pooled_unique<SilentGadget>(1, "ipad");
+        REQUIRE(g->id() == 1);
+    }
+
+    SECTION("PooledPtr doesn't convert to unique_ptr with default deleter")
+    {
+        static_assert(!std::is_convertible_v<PooledPtr<Gadget>, std::unique_ptr<Gadget>>);
+    }
+
+    SECTION("Pooled<T> of polymorphic type may be deleted through pointer to base")
+    {
+        using modern_cpp::Effect;
+        using modern_cpp::Reverb;
+
+        std::unique_ptr<Effect> effect = std::make_unique<Pooled<Reverb>>(42);
+        void* address = effect.get();
+        REQUIRE(effect->name() == "reverb-42");
+        effect.reset(); // Pooled<Reverb>::operator delete
+
+        auto another = std::make_unique<Pooled<Reverb>>(7);
+        REQUIRE(static_cast<Effect*>(another.get()) == address);
+    }
+
+    SECTION("make_pooled_shared")
+    {
+        auto overdrive = make_pooled_shared<Gadget>(1, "boss overdrive");
+        auto another = overdrive;
+
+        REQUIRE(overdrive.use_count() == 2);
+        REQUIRE(another->name() == "boss overdrive");
+    }
+}
+
+TEST_CASE("pooled allocation - alloc/free churn", "[.][benchmark]")
+{
+    using SilentGadget = BasicGadget<SilentTracing>;
+
+    constexpr int count = 1'000;
+
+    BENCHMARK("std::make_unique<Gadget>")
+    {
+        std::vector<std::unique_ptr<SilentGadget>> gadgets;
+        gadgets.reserve(count);
+        for (int i = 0; i < count; ++i)
+            gadgets.push_back(std::make_unique<SilentGadget>(i, "reverb"));
+        return gadgets.size();
+    };
+
+    BENCHMARK("make_pooled_unique<Gadget>")
+    {
+        std::vector<PooledPtr<SilentGadget>> gadgets;
+        gadgets.reserve(count);
+        for (int i = 0; i < count; ++i)
+            gadgets.push_back(make_pooled_unique<SilentGadget>(i, "reverb"));
+        return gadgets.size();
+    };
+
+    BENCHMARK("std::make_shared<Gadget>")
+    {
+        std::vector<std::shared_ptr<SilentGadget>> gadgets;
+        gadgets.reserve(count);
+        for (int i = 0; i < count; ++i)
+            gadgets.push_back(std::make_shared<SilentGadget>(i, "reverb"));
+        return gadgets.size();
+    };
+
+    BENCHMARK("make_pooled_shared<Gadget>")
+    {
+        std::vector<std::shared_ptr<SilentGadget>> gadgets;
+        gadgets.reserve(count);
+        for (int i = 0; i < count; ++i)
+            gadgets.push_back(make_pooled_shared<SilentGadget>(i, "reverb"));
+        return gadgets.size();
+    };
+}
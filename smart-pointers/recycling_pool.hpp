@@ -0,0 +1,159 @@
+#ifndef RECYCLING_POOL_HPP
+#define RECYCLING_POOL_HPP
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace detail
+{
+    template <typename T, typename = void>
+    struct has_class_operator_new : std::false_type
+    {
+    };
+
+    template <typename T>
+    struct has_class_operator_new<T, std::void_t<decltype(T::operator new(std::size_t {}))>> : std::true_type
+    {
+    };
+}
+
+/////////////////////////////////////////////////////////////////
+// Pool recycling memory of destroyed objects of type T (not thread-safe)
+// - acquire() returns std::unique_ptr with deleter returning memory to the pool
+// - memory is allocated with global operator new - objects may be released
+//   from unique_ptr & deleted by legacy code (delete ptr)
+// - objects created with new T may be returned to the pool with recycle()
+// - pool must outlive all unique_ptrs returned from acquire()
+// - over-aligned types & types with class-specific operator new/delete (e.g. PoolAllocated<T>)
+//   are rejected - delete ptr in legacy code must release memory with global operator delete
+//
+template <typename T>
+class RecyclingPool
+{
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "over-aligned types are not supported");
+    static_assert(!detail::has_class_operator_new<T>::value, "types with class-specific operator new are not supported");
+
+    std::vector<void*> free_storage_;
+    std::size_t capacity_;
+    std::size_t hits_ = 0;
+    std::size_t misses_ = 0;
+
+public:
+    class Deleter
+    {
+        RecyclingPool* pool_ = nullptr;
+
+    public:
+        Deleter() = default;
+
+        explicit Deleter(RecyclingPool* pool) noexcept
+            : pool_ {pool}
+        {
+        }
+
+        void operator()(T* ptr) const noexcept
+        {
+            if (pool_)
+                pool_->recycle(ptr);
+            else
+                delete ptr;
+        }
+    };
+
+    using Ptr = std::unique_ptr<T, Deleter>;
+
+    // capacity - max number of memory blocks kept for reuse
+    explicit RecyclingPool(std::size_t capacity)
+        : capacity_ {capacity}
+    {
+        free_storage_.reserve(capacity_);
+    }
+
+    RecyclingPool(const RecyclingPool&) = delete;
+    RecyclingPool& operator=(const RecyclingPool&) = delete;
+
+    ~RecyclingPool()
+    {
+        for (void* storage : free_storage_)
+            ::operator delete(storage);
+    }
+
+    template <typename... TArgs>
+    Ptr acquire(TArgs&&... args)
+    {
+        void* storage = nullptr;
+
+        if (!free_storage_.empty())
+        {
+            storage = free_storage_.back();
+            free_storage_.pop_back();
+            ++hits_;
+        }
+        else
+        {
+            storage = ::operator new(sizeof(T));
+            ++misses_;
+        }
+
+        try
+        {
+            return Ptr(new (storage) T(std::forward<TArgs>(args)...), Deleter {this});
+        }
+        catch (...)
+        {
+            release_storage(storage);
+            throw;
+        }
+    }
+
+    // takes ownership of object created by acquire() or by new T
+    Ptr adopt(T* ptr) noexcept
+    {
+        return Ptr(ptr, Deleter {this});
+    }
+
+    // destroys object & keeps its memory for reuse
+    void recycle(T* ptr) noexcept
+    {
+        if (ptr)
+        {
+            ptr->~T();
+            release_storage(ptr);
+        }
+    }
+
+    std::size_t capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    std::size_t available() const noexcept
+    {
+        return free_storage_.size();
+    }
+
+    std::size_t hits() const noexcept
+    {
+        return hits_;
+    }
+
+    std::size_t misses() const noexcept
+    {
+        return misses_;
+    }
+
+private:
+    void release_storage(void* storage) noexcept
+    {
+        if (free_storage_.size() < capacity_)
+            free_storage_.push_back(storage); // no reallocation - capacity reserved in constructor
+        else
+            ::operator delete(storage);
+    }
+};
+
+#endif // RECYCLING_POOL_HPP
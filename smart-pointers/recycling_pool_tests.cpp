@@ -0,0 +1,108 @@
+#include <memory>
+#include <string>
+
+#include "catch.hpp"
+#include "recycling_pool.hpp"
+#include "utils.hpp"
+
+using namespace Utils;
+
+namespace recycling
+{
+    using GadgetPool = RecyclingPool<Gadget>;
+
+    class EffectFactory
+    {
+        GadgetPool pool_;
+        int id_ = 665;
+
+    public:
+        explicit EffectFactory(size_t capacity)
+            : pool_ {capacity}
+        {
+        }
+
+        GadgetPool::Ptr create(const std::string& name)
+        {
+            return pool_.acquire(++id_, name);
+        }
+
+        GadgetPool& pool()
+        {
+            return pool_;
+        }
+    };
+
+    void use(GadgetPool::Ptr g)
+    {
+        if (g)
+            std::cout << "Using " << g->name() << "\n";
+    } // g is returned to pool
+}
+
+namespace legacy_code
+{
+    Gadget* effect_factory(const std::string& name);
+    void use_and_destroy(Gadget* g);
+}
+
+namespace
+{
+    struct ClassAllocated
+    {
+        static void* operator new(std::size_t size)
+        {
+            return ::operator new(size);
+        }
+
+        static void operator delete(void* ptr) noexcept
+        {
+            ::operator delete(ptr);
+        }
+    };
+}
+
+// RecyclingPool<T> rejects these types - legacy delete wouldn't release memory with global operator delete
+static_assert(!detail::has_class_operator_new<Gadget>::value);
+static_assert(detail::has_class_operator_new<ClassAllocated>::value);
+
+TEST_CASE("recycling effect factory")
+{
+    recycling::EffectFactory factory {2};
+
+    auto fractal = factory.create("fractal");
+    void* fractal_address = fractal.get();
+
+    recycling::use(std::move(fractal));
+    REQUIRE(factory.pool().available() == 1);
+
+    auto kemper = factory.create("kemper");
+    REQUIRE(kemper.get() == fractal_address);
+    REQUIRE(kemper->name() == "kemper");
+    REQUIRE(factory.pool().hits() == 1);
+    REQUIRE(factory.pool().misses() == 1);
+
+    SECTION("pool keeps at most capacity blocks")
+    {
+        {
+            auto e1 = factory.create("e1");
+            auto e2 = factory.create("e2");
+            auto e3 = factory.create("e3");
+        }
+
+        REQUIRE(factory.pool().available() == 2);
+    }
+
+    SECTION("interoperability with legacy code")
+    {
+        legacy_code::use_and_destroy(kemper.release()); // memory goes back to the heap
+        REQUIRE(factory.pool().available() == 0);
+
+        factory.pool().recycle(legacy_code::effect_factory("delay")); // memory of legacy object is reused
+        REQUIRE(factory.pool().available() == 1);
+
+        auto adopted = factory.pool().adopt(legacy_code::effect_factory("reverb"));
+        adopted.reset();
+        REQUIRE(factory.pool().available() == 2);
+    }
+}
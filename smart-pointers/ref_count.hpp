@@ -0,0 +1,91 @@
+#ifndef REF_COUNT_HPP
+#define REF_COUNT_HPP
+
+#include <atomic>
+
+namespace Memory
+{
+    /////////////////////////////////////////////////////////////////
+    // RefCountPolicy - thread-safe counter
+    //
+    class AtomicRefCount
+    {
+        std::atomic<long> count_;
+
+    public:
+        explicit AtomicRefCount(long initial = 0) noexcept
+            : count_ {initial}
+        {
+        }
+
+        void increment() noexcept
+        {
+            count_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // returns counter value after decrement
+        long decrement() noexcept
+        {
+            return count_.fetch_sub(1, std::memory_order_acq_rel) - 1;
+        }
+
+        // used by weak pointers - object can't be resurrected when counter has dropped to zero
+        bool increment_if_not_zero() noexcept
+        {
+            long count = count_.load(std::memory_order_relaxed);
+
+            while (count != 0)
+            {
+                if (count_.compare_exchange_weak(count, count + 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+                    return true;
+            }
+
+            return false;
+        }
+
+        long load() const noexcept
+        {
+            return count_.load(std::memory_order_acquire);
+        }
+    };
+
+    /////////////////////////////////////////////////////////////////
+    // RefCountPolicy - plain counter for objects shared within one thread
+    //
+    class PlainRefCount
+    {
+        long count_;
+
+    public:
+        explicit PlainRefCount(long initial = 0) noexcept
+            : count_ {initial}
+        {
+        }
+
+        void increment() noexcept
+        {
+            ++count_;
+        }
+
+        long decrement() noexcept
+        {
+            return --count_;
+        }
+
+        bool increment_if_not_zero() noexcept
+        {
+            if (count_ == 0)
+                return false;
+
+            ++count_;
+            return true;
+        }
+
+        long load() const noexcept
+        {
+            return count_;
+        }
+    };
+}
+
+#endif // REF_COUNT_HPP
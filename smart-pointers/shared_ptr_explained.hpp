@@ -0,0 +1,351 @@
+#ifndef SHARED_PTR_EXPLAINED_HPP
+#define SHARED_PTR_EXPLAINED_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "ref_count.hpp"
+
+namespace explain
+{
+    namespace detail
+    {
+        template <typename RefCountPolicy>
+        class control_block_base
+        {
+            RefCountPolicy shared_count_ {1};
+            RefCountPolicy weak_count_ {1}; // +1 held together by all shared owners
+
+            virtual void destroy_object() noexcept = 0;
+
+        public:
+            control_block_base() = default;
+            control_block_base(const control_block_base&) = delete;
+            control_block_base& operator=(const control_block_base&) = delete;
+            virtual ~control_block_base() = default;
+
+            void add_shared() noexcept
+            {
+                shared_count_.increment();
+            }
+
+            bool try_add_shared() noexcept
+            {
+                return shared_count_.increment_if_not_zero();
+            }
+
+            void release_shared() noexcept
+            {
+                if (shared_count_.decrement() == 0)
+                {
+                    destroy_object();
+                    release_weak();
+                }
+            }
+
+            void add_weak() noexcept
+            {
+                weak_count_.increment();
+            }
+
+            void release_weak() noexcept
+            {
+                if (weak_count_.decrement() == 0)
+                    delete this;
+            }
+
+            long use_count() const noexcept
+            {
+                return shared_count_.load();
+            }
+        };
+
+        // shared_ptr<T>(new T()) - object & control block are allocated separately
+        template <typename T, typename RefCountPolicy>
+        class pointer_control_block : public control_block_base<RefCountPolicy>
+        {
+            T* ptr_;
+
+            void destroy_object() noexcept override
+            {
+                delete ptr_;
+            }
+
+        public:
+            explicit pointer_control_block(T* ptr)
+                : ptr_ {ptr}
+            {
+            }
+        };
+
+        // make_shared<T>() - object is stored inside control block (single allocation)
+        template <typename T, typename RefCountPolicy>
+        class inplace_control_block : public control_block_base<RefCountPolicy>
+        {
+            alignas(T) std::byte storage_[sizeof(T)];
+
+            void destroy_object() noexcept override
+            {
+                object()->~T();
+            }
+
+        public:
+            template <typename... TArgs>
+            explicit inplace_control_block(TArgs&&... args)
+            {
+                new (storage_) T(std::forward<TArgs>(args)...);
+            }
+
+            T* object() noexcept
+            {
+                return std::launder(reinterpret_cast<T*>(storage_));
+            }
+        };
+    }
+
+    template <typename T, typename RefCountPolicy>
+    class weak_ptr;
+
+    /////////////////////////////////////////////////////////////////
+    // RefCountPolicy:
+    // - Memory::AtomicRefCount - pointers to the same object may be copied in many threads
+    // - Memory::PlainRefCount - all owners live in one thread (no atomic instructions)
+    //
+    template <typename T, typename RefCountPolicy = Memory::AtomicRefCount>
+    class shared_ptr
+    {
+        using control_block = detail::control_block_base<RefCountPolicy>;
+
+        T* ptr_ = nullptr;
+        control_block* ctrl_ = nullptr;
+
+        template <typename U, typename P>
+        friend class shared_ptr;
+
+        friend class weak_ptr<T, RefCountPolicy>;
+
+        template <typename U, typename P, typename... TArgs>
+        friend shared_ptr<U, P> make_shared(TArgs&&... args);
+
+        shared_ptr(T* ptr, control_block* ctrl) noexcept
+            : ptr_ {ptr}
+            , ctrl_ {ctrl}
+        {
+        }
+
+    public:
+        shared_ptr() = default;
+
+        shared_ptr(std::nullptr_t) noexcept
+        {
+        }
+
+        explicit shared_ptr(T* ptr)
+            : ptr_ {ptr}
+        {
+            try
+            {
+                ctrl_ = new detail::pointer_control_block<T, RefCountPolicy>(ptr);
+            }
+            catch (...)
+            {
+                delete ptr;
+                throw;
+            }
+        }
+
+        shared_ptr(const shared_ptr& other) noexcept
+            : ptr_ {other.ptr_}
+            , ctrl_ {other.ctrl_}
+        {
+            if (ctrl_)
+                ctrl_->add_shared();
+        }
+
+        template <typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+        shared_ptr(const shared_ptr<U, RefCountPolicy>& other) noexcept
+            : ptr_ {other.ptr_}
+            , ctrl_ {other.ctrl_}
+        {
+            if (ctrl_)
+                ctrl_->add_shared();
+        }
+
+        shared_ptr(shared_ptr&& other) noexcept
+            : ptr_ {std::exchange(other.ptr_, nullptr)}
+            , ctrl_ {std::exchange(other.ctrl_, nullptr)}
+        {
+        }
+
+        shared_ptr& operator=(const shared_ptr& other) noexcept
+        {
+            shared_ptr(other).swap(*this);
+            return *this;
+        }
+
+        shared_ptr& operator=(shared_ptr&& other) noexcept
+        {
+            shared_ptr(std::move(other)).swap(*this);
+            return *this;
+        }
+
+        ~shared_ptr()
+        {
+            if (ctrl_)
+                ctrl_->release_shared();
+        }
+
+        void swap(shared_ptr& other) noexcept
+        {
+            std::swap(ptr_, other.ptr_);
+            std::swap(ctrl_, other.ctrl_);
+        }
+
+        void reset() noexcept
+        {
+            shared_ptr().swap(*this);
+        }
+
+        T* get() const noexcept
+        {
+            return ptr_;
+        }
+
+        T& operator*() const noexcept
+        {
+            return *ptr_;
+        }
+
+        T* operator->() const noexcept
+        {
+            return ptr_;
+        }
+
+        long use_count() const noexcept
+        {
+            return ctrl_ ? ctrl_->use_count() : 0;
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return ptr_ != nullptr;
+        }
+
+        bool operator==(std::nullptr_t) const noexcept
+        {
+            return ptr_ == nullptr;
+        }
+
+        bool operator!=(std::nullptr_t) const noexcept
+        {
+            return ptr_ != nullptr;
+        }
+    };
+
+    template <typename T, typename RefCountPolicy = Memory::AtomicRefCount>
+    class weak_ptr
+    {
+        using control_block = detail::control_block_base<RefCountPolicy>;
+
+        T* ptr_ = nullptr;
+        control_block* ctrl_ = nullptr;
+
+    public:
+        weak_ptr() = default;
+
+        weak_ptr(const shared_ptr<T, RefCountPolicy>& sp) noexcept
+            : ptr_ {sp.ptr_}
+            , ctrl_ {sp.ctrl_}
+        {
+            if (ctrl_)
+                ctrl_->add_weak();
+        }
+
+        weak_ptr(const weak_ptr& other) noexcept
+            : ptr_ {other.ptr_}
+            , ctrl_ {other.ctrl_}
+        {
+            if (ctrl_)
+                ctrl_->add_weak();
+        }
+
+        weak_ptr(weak_ptr&& other) noexcept
+            : ptr_ {std::exchange(other.ptr_, nullptr)}
+            , ctrl_ {std::exchange(other.ctrl_, nullptr)}
+        {
+        }
+
+        weak_ptr& operator=(const weak_ptr& other) noexcept
+        {
+            weak_ptr(other).swap(*this);
+            return *this;
+        }
+
+        weak_ptr& operator=(weak_ptr&& other) noexcept
+        {
+            weak_ptr(std::move(other)).swap(*this);
+            return *this;
+        }
+
+        weak_ptr& operator=(const shared_ptr<T, RefCountPolicy>& sp) noexcept
+        {
+            weak_ptr(sp).swap(*this);
+            return *this;
+        }
+
+        ~weak_ptr()
+        {
+            if (ctrl_)
+                ctrl_->release_weak();
+        }
+
+        void swap(weak_ptr& other) noexcept
+        {
+            std::swap(ptr_, other.ptr_);
+            std::swap(ctrl_, other.ctrl_);
+        }
+
+        long use_count() const noexcept
+        {
+            return ctrl_ ? ctrl_->use_count() : 0;
+        }
+
+        bool expired() const noexcept
+        {
+            return use_count() == 0;
+        }
+
+        shared_ptr<T, RefCountPolicy> lock() const noexcept
+        {
+            if (ctrl_ && ctrl_->try_add_shared())
+                return shared_ptr<T, RefCountPolicy>(ptr_, ctrl_);
+
+            return nullptr;
+        }
+    };
+
+    // object & control block in one allocation
+    template <typename T, typename RefCountPolicy = Memory::AtomicRefCount, typename... TArgs>
+    shared_ptr<T, RefCountPolicy> make_shared(TArgs&&... args)
+    {
+        auto* ctrl = new detail::inplace_control_block<T, RefCountPolicy>(std::forward<TArgs>(args)...);
+        return shared_ptr<T, RefCountPolicy>(ctrl->object(), ctrl);
+    }
+
+    // ownership shared only within one thread
+    template <typename T>
+    using local_shared_ptr = shared_ptr<T, Memory::PlainRefCount>;
+
+    template <typename T>
+    using local_weak_ptr = weak_ptr<T, Memory::PlainRefCount>;
+
+    template <typename T, typename... TArgs>
+    local_shared_ptr<T> make_local_shared(TArgs&&... args)
+    {
+        return make_shared<T, Memory::PlainRefCount>(std::forward<TArgs>(args)...);
+    }
+}
+
+#endif // SHARED_PTR_EXPLAINED_HPP
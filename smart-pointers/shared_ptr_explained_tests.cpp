@@ -0,0 +1,126 @@
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch.hpp"
+#include "instrumentation.hpp"
+#include "shared_ptr_explained.hpp"
+#include "utils.hpp"
+
+using namespace Utils;
+
+TEMPLATE_TEST_CASE("explain::shared_ptr & weak_ptr", "", Memory::AtomicRefCount, Memory::PlainRefCount)
+{
+    using GadgetPtr = explain::shared_ptr<Gadget, TestType>;
+
+    std::map<std::string, GadgetPtr> effect_chain;
+
+    explain::weak_ptr<Gadget, TestType> weak_overdrive_effect;
+
+    {
+        auto overdrive = explain::make_shared<Gadget, TestType>(1, "boss overdrive"); // RC: 1
+
+        auto another_sp = overdrive; // RC: 2
+
+        weak_overdrive_effect = overdrive; // RC: 2
+
+        REQUIRE(overdrive.use_count() == 2);
+
+        effect_chain.emplace("1st", overdrive); // RC: 3
+
+        REQUIRE(overdrive.use_count() == 3);
+    } // RC: 1
+
+    REQUIRE(effect_chain["1st"].use_count() == 1);
+    REQUIRE(effect_chain["1st"]->name() == "boss overdrive");
+
+    GadgetPtr temp_effect = weak_overdrive_effect.lock(); // RC: 2
+    REQUIRE(temp_effect.use_count() == 2);
+
+    temp_effect.reset(); // RC: 1
+    effect_chain.clear(); // RC: 0
+
+    REQUIRE(weak_overdrive_effect.expired());
+    temp_effect = weak_overdrive_effect.lock();
+    REQUIRE(temp_effect == nullptr);
+}
+
+TEST_CASE("explain::make_shared - single allocation")
+{
+    using namespace Instrumentation;
+
+    SECTION("make_shared")
+    {
+        AllocationCounter allocations;
+
+        auto sp = explain::make_shared<InstrumentedGadget>(1, "reverb");
+
+        auto allocs = allocations.allocations();
+        REQUIRE(allocs == 1);
+    }
+
+    SECTION("shared_ptr(new T)")
+    {
+        AllocationCounter allocations;
+
+        explain::shared_ptr<InstrumentedGadget> sp(new InstrumentedGadget(1, "reverb"));
+
+        auto allocs = allocations.allocations();
+        REQUIRE(allocs == 2);
+    }
+
+    SECTION("conversion to pointer to base")
+    {
+        struct Derived : InstrumentedGadget
+        {
+            using InstrumentedGadget::InstrumentedGadget;
+        };
+
+        explain::local_shared_ptr<InstrumentedGadget> sp = explain::make_local_shared<Derived>(1, "reverb");
+        REQUIRE(sp->name() == "reverb");
+    }
+}
+
+namespace
+{
+    template <typename TPtr>
+    size_t copy_heavy_workload(const TPtr& ptr)
+    {
+        std::vector<TPtr> copies;
+        copies.reserve(1000);
+
+        for (int i = 0; i < 1000; ++i)
+            copies.push_back(ptr);
+
+        return copies.size();
+    }
+}
+
+TEST_CASE("explain::shared_ptr vs. std::shared_ptr - copies", "[.][benchmark]")
+{
+    using SilentGadget = BasicGadget<SilentTracing>;
+
+    // libstdc++ skips atomic operations in shared_ptr until the first thread is started
+    std::thread {[] {}}.join();
+
+    auto std_sp = std::make_shared<SilentGadget>(1, "reverb");
+    auto atomic_sp = explain::make_shared<SilentGadget>(1, "reverb");
+    auto local_sp = explain::make_local_shared<SilentGadget>(1, "reverb");
+
+    BENCHMARK("std::shared_ptr")
+    {
+        return copy_heavy_workload(std_sp);
+    };
+
+    BENCHMARK("explain::shared_ptr - atomic counters")
+    {
+        return copy_heavy_workload(atomic_sp);
+    };
+
+    BENCHMARK("explain::local_shared_ptr - plain counters")
+    {
+        return copy_heavy_workload(local_sp);
+    };
+}
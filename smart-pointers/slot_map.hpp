@@ -0,0 +1,145 @@
+#ifndef SLOT_MAP_HPP
+#define SLOT_MAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+/////////////////////////////////////////////////////////////////
+// Objects stored contiguously in slots & referenced by 64-bit handles (index + generation)
+// - erasing an object increments generation of its slot - old handles become stale
+// - resolving a handle: bounds check + comparison of generations (no atomics, no ref counting)
+// - not thread-safe; pointers returned by get() are invalidated by emplace()
+//
+template <typename T>
+class SlotMap
+{
+public:
+    struct Handle
+    {
+        std::uint32_t index = 0;
+        std::uint32_t generation = 0; // slot generations start from 1 - default handle is always stale
+
+        bool operator==(const Handle& other) const noexcept
+        {
+            return index == other.index && generation == other.generation;
+        }
+
+        bool operator!=(const Handle& other) const noexcept
+        {
+            return !(*this == other);
+        }
+    };
+
+    static_assert(sizeof(Handle) == sizeof(std::uint64_t));
+
+private:
+    static constexpr std::uint32_t end_of_free_list = UINT32_MAX;
+
+    struct Slot
+    {
+        std::optional<T> value;
+        std::uint32_t generation = 1;
+        std::uint32_t next_free = end_of_free_list;
+    };
+
+    std::vector<Slot> slots_;
+    std::uint32_t free_head_ = end_of_free_list;
+    std::size_t size_ = 0;
+
+public:
+    SlotMap() = default;
+
+    void reserve(std::size_t size)
+    {
+        slots_.reserve(size);
+    }
+
+    std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    template <typename... TArgs>
+    Handle emplace(TArgs&&... args)
+    {
+        std::uint32_t index;
+
+        if (free_head_ != end_of_free_list)
+        {
+            index = free_head_;
+            slots_[index].value.emplace(std::forward<TArgs>(args)...);
+            free_head_ = slots_[index].next_free;
+        }
+        else
+        {
+            index = static_cast<std::uint32_t>(slots_.size());
+            Slot& slot = slots_.emplace_back();
+
+            try
+            {
+                slot.value.emplace(std::forward<TArgs>(args)...);
+            }
+            catch (...)
+            {
+                slots_.pop_back(); // empty slot would be neither free nor occupied
+                throw;
+            }
+        }
+
+        ++size_;
+
+        return Handle {index, slots_[index].generation};
+    }
+
+    // returns nullptr for stale handle
+    T* get(Handle handle) noexcept
+    {
+        if (handle.index < slots_.size() && slots_[handle.index].generation == handle.generation)
+            return &*slots_[handle.index].value;
+
+        return nullptr;
+    }
+
+    const T* get(Handle handle) const noexcept
+    {
+        return const_cast<SlotMap&>(*this).get(handle);
+    }
+
+    bool contains(Handle handle) const noexcept
+    {
+        return get(handle) != nullptr;
+    }
+
+    bool erase(Handle handle)
+    {
+        if (!contains(handle))
+            return false;
+
+        Slot& slot = slots_[handle.index];
+        slot.value.reset();
+        ++slot.generation;
+        slot.next_free = free_head_;
+        free_head_ = handle.index;
+        --size_;
+
+        return true;
+    }
+
+    template <typename F>
+    void for_each(F f)
+    {
+        for (Slot& slot : slots_)
+            if (slot.value)
+                f(*slot.value);
+    }
+};
+
+#endif // SLOT_MAP_HPP
@@ -0,0 +1,117 @@
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "catch.hpp"
+#include "slot_map.hpp"
+#include "utils.hpp"
+
+using namespace Utils;
+
+TEST_CASE("slot map with generational handles")
+{
+    SlotMap<Gadget> effects;
+
+    auto overdrive = effects.emplace(1, "boss overdrive");
+    auto reverb = effects.emplace(2, "reverb");
+
+    REQUIRE(effects.size() == 2);
+    REQUIRE(effects.get(overdrive)->name() == "boss overdrive");
+    REQUIRE(effects.get(reverb)->name() == "reverb");
+
+    SECTION("default handle is stale")
+    {
+        REQUIRE(effects.get(SlotMap<Gadget>::Handle {}) == nullptr);
+    }
+
+    SECTION("handle becomes stale when object is erased")
+    {
+        REQUIRE(effects.erase(overdrive));
+        REQUIRE_FALSE(effects.erase(overdrive));
+
+        REQUIRE(effects.get(overdrive) == nullptr);
+        REQUIRE(effects.size() == 1);
+
+        SECTION("stale handle does not resolve to an object reusing the slot")
+        {
+            auto delay = effects.emplace(3, "delay");
+
+            REQUIRE(delay.index == overdrive.index);
+            REQUIRE(effects.get(overdrive) == nullptr);
+            REQUIRE(effects.get(delay)->name() == "delay");
+        }
+    }
+}
+
+namespace
+{
+    struct ThrowingEffect
+    {
+        explicit ThrowingEffect(bool should_throw)
+        {
+            if (should_throw)
+                throw std::runtime_error("effect can't be created");
+        }
+    };
+}
+
+TEST_CASE("slot map - exception thrown by constructor of an object")
+{
+    SlotMap<ThrowingEffect> effects;
+
+    REQUIRE_THROWS_AS(effects.emplace(true), std::runtime_error);
+    REQUIRE(effects.size() == 0);
+
+    auto handle = effects.emplace(false);
+
+    REQUIRE(handle.index == 0); // slot of failed emplace is not leaked
+    REQUIRE(effects.get(handle) != nullptr);
+    REQUIRE(effects.size() == 1);
+}
+
+TEST_CASE("slot map handles vs. weak_ptr::lock()", "[.][benchmark]")
+{
+    using SilentGadget = BasicGadget<SilentTracing>;
+    constexpr int count = 1'000;
+
+    // libstdc++ skips atomic operations in shared_ptr until the first thread is started
+    std::thread {[] {}}.join();
+
+    std::vector<std::shared_ptr<SilentGadget>> owners;
+    std::vector<std::weak_ptr<SilentGadget>> weak_effects;
+    SlotMap<SilentGadget> effects;
+    std::vector<SlotMap<SilentGadget>::Handle> handles;
+
+    for (int i = 0; i < count; ++i)
+    {
+        owners.push_back(std::make_shared<SilentGadget>(i));
+        weak_effects.push_back(owners.back());
+        handles.push_back(effects.emplace(i));
+    }
+
+    // every other effect is destroyed
+    for (int i = 0; i < count; i += 2)
+    {
+        owners[i].reset();
+        effects.erase(handles[i]);
+    }
+
+    BENCHMARK("weak_ptr::lock()")
+    {
+        int sum = 0;
+        for (const auto& weak_effect : weak_effects)
+            if (auto effect = weak_effect.lock())
+                sum += effect->id();
+        return sum;
+    };
+
+    BENCHMARK("SlotMap::get(handle)")
+    {
+        int sum = 0;
+        for (const auto& handle : handles)
+            if (auto* effect = effects.get(handle))
+                sum += effect->id();
+        return sum;
+    };
+}
@@ -0,0 +1,160 @@
+#ifndef POLYMORPHIC_VALUE_HPP
+#define POLYMORPHIC_VALUE_HPP
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/////////////////////////////////////////////////////////////////
+// Owns an object of any class derived from Base (like std::unique_ptr<Base>)
+// - objects up to BufferSize bytes are stored inline - no heap allocation
+// - bigger objects (or objects with throwing move constructor) are allocated on the heap
+// - calls of virtual functions of Base work as usual
+//
+template <typename Base, std::size_t BufferSize = 4 * sizeof(void*)>
+class PolymorphicValue
+{
+    struct Operations
+    {
+        void (*destroy)(Base* ptr) noexcept;
+        Base* (*move)(Base* ptr, void* buffer) noexcept; // returns pointer to moved object
+        bool is_inline;
+    };
+
+    template <typename T>
+    static constexpr bool fits_inline = sizeof(T) <= BufferSize
+        && alignof(T) <= alignof(std::max_align_t)
+        && std::is_nothrow_move_constructible_v<T>;
+
+    template <typename T>
+    static constexpr Operations inline_operations = {
+        [](Base* ptr) noexcept { static_cast<T*>(ptr)->~T(); },
+        [](Base* ptr, void* buffer) noexcept -> Base* {
+            T* target = new (buffer) T(std::move(*static_cast<T*>(ptr)));
+            static_cast<T*>(ptr)->~T();
+            return target;
+        },
+        true};
+
+    template <typename T>
+    static constexpr Operations heap_operations = {
+        [](Base* ptr) noexcept { delete static_cast<T*>(ptr); },
+        [](Base* ptr, void*) noexcept { return ptr; },
+        false};
+
+    alignas(std::max_align_t) std::byte buffer_[BufferSize];
+    Base* ptr_ = nullptr;
+    const Operations* operations_ = nullptr;
+
+public:
+    PolymorphicValue() = default;
+
+    PolymorphicValue(std::nullptr_t) noexcept
+    {
+    }
+
+    template <typename T, typename... TArgs>
+    explicit PolymorphicValue(std::in_place_type_t<T>, TArgs&&... args)
+    {
+        static_assert(std::is_base_of_v<Base, T>, "T must be derived from Base");
+
+        if constexpr (fits_inline<T>)
+        {
+            ptr_ = new (buffer_) T(std::forward<TArgs>(args)...);
+            operations_ = &inline_operations<T>;
+        }
+        else
+        {
+            ptr_ = new T(std::forward<TArgs>(args)...);
+            operations_ = &heap_operations<T>;
+        }
+    }
+
+    template <typename T, typename = std::enable_if_t<std::is_base_of_v<Base, std::decay_t<T>> && !std::is_same_v<std::decay_t<T>, PolymorphicValue>>>
+    PolymorphicValue(T&& object)
+        : PolymorphicValue(std::in_place_type<std::decay_t<T>>, std::forward<T>(object))
+    {
+    }
+
+    // adopts object already allocated on the heap
+    template <typename T, typename = std::enable_if_t<std::is_base_of_v<Base, T>>>
+    PolymorphicValue(std::unique_ptr<T> object) noexcept
+        : ptr_ {object.release()}
+        , operations_ {ptr_ ? &heap_operations<T> : nullptr}
+    {
+    }
+
+    PolymorphicValue(const PolymorphicValue&) = delete;
+    PolymorphicValue& operator=(const PolymorphicValue&) = delete;
+
+    PolymorphicValue(PolymorphicValue&& other) noexcept
+    {
+        move_from(other);
+    }
+
+    PolymorphicValue& operator=(PolymorphicValue&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            move_from(other);
+        }
+
+        return *this;
+    }
+
+    ~PolymorphicValue()
+    {
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        if (ptr_)
+        {
+            operations_->destroy(ptr_);
+            ptr_ = nullptr;
+            operations_ = nullptr;
+        }
+    }
+
+    bool is_inline() const noexcept
+    {
+        return operations_ && operations_->is_inline;
+    }
+
+    Base* get() const noexcept
+    {
+        return ptr_;
+    }
+
+    Base& operator*() const noexcept
+    {
+        return *ptr_;
+    }
+
+    Base* operator->() const noexcept
+    {
+        return ptr_;
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return ptr_ != nullptr;
+    }
+
+private:
+    void move_from(PolymorphicValue& other) noexcept
+    {
+        if (other.ptr_)
+        {
+            ptr_ = other.operations_->move(other.ptr_, buffer_);
+            operations_ = std::exchange(other.operations_, nullptr);
+            other.ptr_ = nullptr;
+        }
+    }
+};
+
+#endif // POLYMORPHIC_VALUE_HPP
@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "catch.hpp"
+#include "polymorphic_value.hpp"
 
 using namespace std;
 
@@ -303,12 +304,25 @@ namespace dynamic_polimorphism
         }
     };
 
-    class Guitar
+    class ActivePickup : public Pickup
+    {
+        std::unique_ptr<int> battery_level_ = std::make_unique<int>(100); // move-only
+
+    public:
+        void give_sound() override
+        {
+            std::cout << "Loud & clean sound of active pickup - battery " << *battery_level_ << "%...\n";
+        }
+    };
+
+    //                PickupPtr: std::unique_ptr<Pickup> or PolymorphicValue<Pickup>
+    template <typename PickupPtr>
+    class BasicGuitar
     {
-        std::unique_ptr<Pickup> bridge_pickup_;
+        PickupPtr bridge_pickup_;
 
     public:
-        Guitar(std::unique_ptr<Pickup> pickup)
+        BasicGuitar(PickupPtr pickup)
             : bridge_pickup_ {std::move(pickup)}
         {
         }
@@ -318,11 +332,16 @@ namespace dynamic_polimorphism
             bridge_pickup_->give_sound();
         }
 
-        void reset_pickup(std::unique_ptr<Pickup> new_pickup)
+        void reset_pickup(PickupPtr new_pickup)
         {
             bridge_pickup_ = std::move(new_pickup);
         }
     };
+
+    using Guitar = BasicGuitar<std::unique_ptr<Pickup>>;
+
+    // pickups are stored inside guitar - no allocations
+    using InplaceGuitar = BasicGuitar<PolymorphicValue<Pickup>>;
 }
 
 namespace static_polymorphism
@@ -372,6 +391,49 @@ TEST_CASE("dynamic polimorphism")
     les_paul.play();
 }
 
+TEST_CASE("dynamic polimorphism - pickups stored inline")
+{
+    using namespace dynamic_polimorphism;
+
+    InplaceGuitar fender {SingleCoil {}};
+    fender.play();
+
+    fender.reset_pickup(Humbucker {});
+    fender.play();
+
+    fender.reset_pickup(ActivePickup {});
+    fender.play();
+
+    SECTION("small objects are stored inline")
+    {
+        PolymorphicValue<Pickup> pickup {ActivePickup {}};
+        REQUIRE(pickup.is_inline());
+
+        PolymorphicValue<Pickup> moved_pickup = std::move(pickup);
+        REQUIRE(moved_pickup.is_inline());
+        REQUIRE_FALSE(pickup);
+    }
+
+    SECTION("big objects are allocated on the heap")
+    {
+        struct VintagePickup : Pickup
+        {
+            char windings[256] = {};
+
+            void give_sound() override
+            {
+                std::cout << "Warm vintage sound...\n";
+            }
+        };
+
+        PolymorphicValue<Pickup> pickup {std::in_place_type<VintagePickup>};
+        REQUIRE_FALSE(pickup.is_inline());
+
+        InplaceGuitar strat {std::move(pickup)};
+        strat.play();
+    }
+}
+
 TEST_CASE("static polimorphism")
 {
     using namespace static_polymorphism;